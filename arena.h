@@ -0,0 +1,138 @@
+/**
+ * ======================================================================================
+ * SESSION ARENAS
+ * Per-session bump allocation. A session's coroutine frames and its per-game state
+ * (boards, words) come out of its own arena: chunks are kept for the life of the
+ * session, so once a session has played a game or two it stops touching the global
+ * heap, and server worker threads no longer meet each other in malloc. Frames are
+ * freed in call order, so they pop straight off the top; a finished game rewinds its
+ * arena to where the game began in one step.
+ * ======================================================================================
+ */
+
+#ifndef GAMEHUB_ARENA_H
+#define GAMEHUB_ARENA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+class SessionArena : public std::pmr::memory_resource {
+public:
+    static constexpr std::size_t FIRST_CHUNK = 1024;      // Enough for an idle session's frames; later chunks double
+
+    // Where the arena stood; release() rewinds to it.
+    struct Mark {
+        std::size_t chunk, used;
+    };
+
+    SessionArena() = default;
+    SessionArena(const SessionArena&) = delete;
+    SessionArena& operator=(const SessionArena&) = delete;
+
+    Mark mark() const { return { current, used }; }
+
+    // Everything allocated since `m` is gone. The caller guarantees none of it is
+    // still in use; chunks stay allocated for reuse.
+    void release(Mark m) {
+        current = m.chunk;
+        used = m.used;
+    }
+
+    void reset() { release({ 0, 0 }); }
+
+    // Bytes held from the heap, for reporting.
+    std::size_t reserved() const {
+        std::size_t total = 0;
+        for (const Chunk& c : chunks) total += c.size;
+        return total;
+    }
+
+private:
+    struct Chunk {
+        std::unique_ptr<std::byte[]> memory;
+        std::size_t size;
+    };
+
+    void* do_allocate(std::size_t bytes, std::size_t align) override {
+        while (true) {
+            // Current chunk first, then any kept chunk after it
+            for (; current < chunks.size(); current++, used = 0) {
+                Chunk& c = chunks[current];
+                std::uintptr_t base = reinterpret_cast<std::uintptr_t>(c.memory.get());
+                std::size_t start = ((base + used + align - 1) & ~(align - 1)) - base;
+                if (start + bytes <= c.size) {
+                    used = start + bytes;
+                    return c.memory.get() + start;
+                }
+            }
+            // A new chunk, at least double the last and big enough for this request
+            std::size_t size = std::max(chunks.empty() ? FIRST_CHUNK : chunks.back().size * 2, bytes + align);
+            chunks.push_back(Chunk{ std::unique_ptr<std::byte[]>(new std::byte[size]), size });
+            current = chunks.size() - 1;
+            used = 0;
+        }
+    }
+
+    // Only the most recent allocation can be handed back early; anything else waits
+    // for the next release() or reset().
+    void do_deallocate(void* p, std::size_t bytes, std::size_t) override {
+        if (current >= chunks.size()) return;
+        std::byte* base = chunks[current].memory.get();
+        std::byte* at = static_cast<std::byte*>(p);
+        if (at >= base && at + bytes == base + used) used = static_cast<std::size_t>(at - base);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    std::vector<Chunk> chunks;
+    std::size_t current = 0;
+    std::size_t used = 0;
+};
+
+// Rewinds the arena when the scope ends: declare it at the start of a game, before
+// anything the game allocates.
+class ArenaScope {
+public:
+    explicit ArenaScope(SessionArena& arena) : arena(arena), start(arena.mark()) {}
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+    ~ArenaScope() { arena.release(start); }
+
+private:
+    SessionArena& arena;
+    SessionArena::Mark start;
+};
+
+// The arena of the session running on this thread. Frames created with nothing bound
+// (the server loop starting a session) come from the ordinary heap.
+inline SessionArena*& arena_binding() {
+    thread_local SessionArena* bound = nullptr;
+    return bound;
+}
+
+// --- COROUTINE FRAMES ---
+
+// Each frame records which arena (if any) it came from, so it can be freed from any
+// thread and after the binding has changed.
+constexpr std::size_t FRAME_HEADER = alignof(std::max_align_t);
+
+inline void* frame_allocate(std::size_t bytes) {
+    SessionArena* arena = arena_binding();
+    void* block = arena ? arena->allocate(bytes + FRAME_HEADER, FRAME_HEADER) : ::operator new(bytes + FRAME_HEADER);
+    *static_cast<SessionArena**>(block) = arena;
+    return static_cast<std::byte*>(block) + FRAME_HEADER;
+}
+
+inline void frame_free(void* frame, std::size_t bytes) {
+    void* block = static_cast<std::byte*>(frame) - FRAME_HEADER;
+    SessionArena* arena = *static_cast<SessionArena**>(block);
+    if (arena) arena->deallocate(block, bytes + FRAME_HEADER, FRAME_HEADER);
+    else ::operator delete(block);
+}
+
+#endif
@@ -0,0 +1,303 @@
+/**
+ * ======================================================================================
+ * MICROBENCHMARKS
+ * The engine kernels and the UI's hot paths, each timed on its own:
+ *
+ *     g++ -std=c++20 -O2 -pthread bench.cpp -o gamehub-bench && ./gamehub-bench
+ *
+ * Every kernel walks a fixed table of inputs built from one seed. It runs in batches
+ * sized to about 10 ms each; the median and the fastest batch are reported per
+ * operation. The check column folds the results of one pass over the inputs, so it
+ * is the same on every run and every machine: if it changes, the kernel's answers
+ * changed, not just its speed. One line per kernel, space separated, ready for `awk`
+ * or for diffing against the last release.
+ * ======================================================================================
+ */
+
+// GCC treats an included .cpp like a header and warns about the UI's coroutine frames
+// holding local types; they never leave this one translation unit.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wsubobject-linkage"
+#endif
+
+#define GAMEHUB_NO_MAIN
+#include "main.cpp"
+
+#include <sstream>
+
+constexpr int BENCH_INPUTS = 4096;              // Table size for the cheap kernels
+constexpr int BENCH_BATCHES = 15;
+constexpr double BENCH_BATCH_MS = 10;
+constexpr uint64_t BENCH_SEED = 20240601;
+
+volatile uint64_t benchSink = 0;
+
+struct BenchResult {
+    double medianNs = 0, fastestNs = 0;
+    long long ops = 0;          // Per batch
+    uint64_t check = 0;
+};
+
+// A kernel's `batch(n)` runs operations 0..n-1 (input i % inputs) and returns a
+// checksum of their results.
+struct BenchKernel {
+    const char* name;
+    long long inputs;
+    function<uint64_t(long long)> batch;
+};
+
+BenchResult bench_run(const BenchKernel& kernel, int batches, double batchMs) {
+    using Clock = chrono::steady_clock;
+    auto millis = [](Clock::time_point from) { return chrono::duration<double, milli>(Clock::now() - from).count(); };
+
+    BenchResult r;
+    r.check = kernel.batch(kernel.inputs);     // Doubles as the warm-up
+
+    // Double until a batch is long enough to measure, then scale to the target
+    long long n = 1;
+    while (true) {
+        auto start = Clock::now();
+        kernel.batch(n);
+        double ms = millis(start);
+        if (ms >= batchMs / 4) {
+            n = max(1LL, static_cast<long long>(n * batchMs / ms));
+            break;
+        }
+        n *= 2;
+    }
+
+    vector<double> perOp;
+    for (int b = 0; b < batches; b++) {
+        auto start = Clock::now();
+        uint64_t sum = kernel.batch(n);
+        double ns = millis(start) * 1e6 / static_cast<double>(n);
+        benchSink = sum;    // Keeps the optimizer from dropping the work
+        perOp.push_back(ns);
+    }
+    sort(perOp.begin(), perOp.end());
+    r.medianNs = perOp[perOp.size() / 2];
+    r.fastestNs = perOp.front();
+    r.ops = n;
+    return r;
+}
+
+// --- INPUTS ---
+
+// Positions reached by random play, X first; `finished` keeps the ones with a result.
+vector<TttBoard> bench_ttt_positions(Rng& rng, bool finished) {
+    vector<TttBoard> boards;
+    while (boards.size() < size_t(BENCH_INPUTS)) {
+        TttBoard board;
+        int plies = static_cast<int>(rng.below(10));
+        bool xToMove = true;
+        for (int p = 0; p < plies && check_winner(board) == 'C'; p++) {
+            place_marker(board, random_move(board, rng) + 1, xToMove ? 'X' : 'O');
+            xToMove = !xToMove;
+        }
+        if (!finished && (xToMove || check_winner(board) != 'C')) continue;    // O to move, still open
+        boards.push_back(board);
+    }
+    return boards;
+}
+
+// An early middle game: `stones` random moves in, nobody has won yet.
+vector<MnkBoard> bench_mnk_positions(Rng& rng, MnkRules rules, int stones, int count) {
+    vector<MnkBoard> boards;
+    while (static_cast<int>(boards.size()) < count) {
+        MnkBoard board(rules);
+        int player = MNK_X;
+        bool open = true;
+        for (int s = 0; s < stones && open; s++) {
+            int cell;
+            do cell = static_cast<int>(rng.below(static_cast<uint32_t>(board.cells()))); while (board.at(cell) != MNK_EMPTY);
+            board.play(cell, player);
+            open = !board.wins_at(cell);
+            player = MNK_X + MNK_O - player;
+        }
+        if (open) boards.push_back(move(board));
+    }
+    return boards;
+}
+
+// --- KERNELS ---
+
+vector<BenchKernel> bench_kernels() {
+    Rng rng(BENCH_SEED);
+    vector<BenchKernel> kernels;
+
+    auto anyBoards = make_shared<vector<TttBoard>>(bench_ttt_positions(rng, true));
+    kernels.push_back({ "ttt.check_winner", BENCH_INPUTS, [anyBoards](long long n) {
+        uint64_t sum = 0;
+        for (long long i = 0; i < n; i++) sum += static_cast<uint64_t>(check_winner((*anyBoards)[i % BENCH_INPUTS]));
+        return sum;
+    } });
+
+    // A game's worth of sectors at a time, some of them taken, as a player would type them
+    auto slots = make_shared<vector<int>>();
+    for (int i = 0; i < BENCH_INPUTS; i++) slots->push_back(static_cast<int>(rng.below(9)) + 1);
+    kernels.push_back({ "ttt.place_marker", BENCH_INPUTS, [slots](long long n) {
+        uint64_t sum = 0;
+        TttBoard board;
+        for (long long i = 0; i < n; i++) {
+            if (i % 9 == 0) clearboard(board);
+            sum += place_marker(board, (*slots)[i % BENCH_INPUTS], i & 1 ? 'O' : 'X');
+        }
+        return sum + board.x + board.o;
+    } });
+
+    auto openBoards = make_shared<vector<TttBoard>>(bench_ttt_positions(rng, false));
+    kernels.push_back({ "ttt.computer_turn", BENCH_INPUTS, [openBoards](long long n) {
+        uint64_t sum = 0;
+        for (long long i = 0; i < n; i++) {
+            TttBoard board = (*openBoards)[i % BENCH_INPUTS];
+            computer_turn(board);
+            sum += board.o;
+        }
+        return sum;
+    } });
+
+    // The interactive CPU: a fresh search per move (new_game drops the table), solved
+    // outright on 3x3, node-capped on the bigger boards so the work is the same each time
+    struct SearchCase { const char* name; MnkRules rules; int stones; int count; uint64_t nodes; };
+    static const SearchCase SEARCHES[] = {
+        { "mnk.search.3x3", {3, 3, 3}, 1, 64, 0 },
+        { "mnk.search.7x7", {7, 7, 5}, 4, 16, 20000 },
+        { "mnk.search.15x15", {15, 15, 5}, 6, 16, 20000 },
+    };
+    for (const SearchCase& c : SEARCHES) {
+        auto boards = make_shared<vector<MnkBoard>>(bench_mnk_positions(rng, c.rules, c.stones, c.count));
+        auto search = make_shared<MnkSearch>(16);
+        uint64_t nodes = c.nodes;
+        kernels.push_back({ c.name, static_cast<long long>(boards->size()), [boards, search, nodes](long long n) {
+            MnkLimits limits;
+            limits.milliseconds = 0;
+            limits.nodes = nodes;
+            uint64_t sum = 0;
+            for (long long i = 0; i < n; i++) {
+                MnkBoard& board = (*boards)[i % boards->size()];
+                search->new_game();
+                int player = board.stones() % 2 ? MNK_O : MNK_X;
+                sum += static_cast<uint64_t>(search->search(board, player, limits).move);
+            }
+            return sum;
+        } });
+    }
+
+    // getValidatedInt fed from memory: the replay path, with output hashed instead of
+    // shown. One answer in four follows a typo or an out-of-range try, as people type.
+    auto script = make_shared<istringstream>();
+    {
+        string text;
+        for (int i = 0; i < BENCH_INPUTS; i++) {
+            int pick = static_cast<int>(rng.below(8));
+            if (pick == 0) text += "4x\n";
+            else if (pick == 1) text += "250\n";
+            text += to_string(rng.below(100)) + "\n";
+        }
+        script->str(text);
+    }
+    kernels.push_back({ "input.parse", BENCH_INPUTS, [script](long long n) {
+        OutputDigest digest;
+        terminal().capture(&digest);
+        streambuf* console = cin.rdbuf(script->rdbuf());
+        script->clear();
+        script->seekg(0);
+        uint64_t sum = 0;
+        for (long long i = 0; i < n; i++) {
+            if (i > 0 && i % BENCH_INPUTS == 0) { script->clear(); script->seekg(0); }
+            sum += static_cast<uint64_t>(run_blocking(getValidatedInt("> ", 0, 99)));
+        }
+        cin.rdbuf(console);
+        terminal().capture(nullptr);
+        return sum;
+    } });
+
+    // A whole game: guesses in English letter frequency order, and the masked word
+    // rebuilt after each one as the screen shows it
+    const HangmanDictionary& dictionary = hangman_dictionary();
+    auto words = make_shared<vector<string>>();
+    for (int i = 0; i < BENCH_INPUTS; i++) {
+        words->push_back(string(dictionary.word(dictionary.entry(rng.below(static_cast<uint32_t>(dictionary.size()))))));
+    }
+    kernels.push_back({ "hangman.game", BENCH_INPUTS, [words](long long n) {
+        static const char ORDER[] = "ETAOINSHRDLCUMWFGYPBVKJXQZ";
+        uint64_t sum = 0;
+        char shown[HANGMAN_MAX_LEN + 1];
+        for (long long i = 0; i < n; i++) {
+            const string& word = (*words)[i % BENCH_INPUTS];
+            HangmanGame game;
+            game.word = hangman_word(word);
+            for (int g = 0; g < 26 && game.lives > 0 && !hangman_solved(game); g++) {
+                hangman_guess(game, ORDER[g] - 'A');
+                for (int c = 0; c < game.word.length; c++) shown[c] = game.revealed >> c & 1 ? word[c] : '_';
+                sum += static_cast<unsigned char>(shown[game.word.length - 1]);
+            }
+            sum += static_cast<uint64_t>(game.lives);
+        }
+        return sum;
+    } });
+
+    auto throws = make_shared<vector<uint8_t>>();
+    for (int i = 0; i < BENCH_INPUTS; i++) throws->push_back(static_cast<uint8_t>(rps_random_move(rng) | rps_random_move(rng) << 2));
+    kernels.push_back({ "rps.resolve", BENCH_INPUTS, [throws](long long n) {
+        uint64_t sum = 0;
+        for (long long i = 0; i < n; i++) {
+            int pair = (*throws)[i % BENCH_INPUTS];
+            sum += static_cast<uint64_t>(rps_resolve(pair & 3, pair >> 2));
+        }
+        return sum;
+    } });
+
+    // One full Tic-Tac-Toe screen, composed and sent to a hashing sink
+    auto screens = make_shared<vector<MnkBoard>>(bench_mnk_positions(rng, MnkRules(), 4, 64));
+    kernels.push_back({ "render.frame", static_cast<long long>(screens->size()), [screens](long long n) {
+        OutputDigest digest;
+        terminal().capture(&digest);
+        for (long long i = 0; i < n; i++) {
+            clearScreen();
+            drawHeader("TIC-TAC-TOE: PvCPU");
+            show_board((*screens)[i % screens->size()]);
+            out() << "\n\tSelect Sector (1-9) > ";
+            terminal().present();
+        }
+        terminal().capture(nullptr);
+        return digest.hash;
+    } });
+
+    return kernels;
+}
+
+int main(int argc, char* argv[]) {
+    string filter;
+    int batches = BENCH_BATCHES;
+    double batchMs = BENCH_BATCH_MS;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (arg == "--batches" && i + 1 < argc) {
+            batches = max(1, atoi(argv[++i]));
+        } else if (arg == "--batch-ms" && i + 1 < argc) {
+            batchMs = max(0.1, atof(argv[++i]));
+        } else {
+            cerr << "Unknown option: " << arg << "\n"
+                 << "Usage: " << argv[0] << " [--filter SUBSTRING] [--batches N] [--batch-ms MS]\n";
+            return 1;
+        }
+    }
+
+    // The UI paths run as the replay does: scripted input, no pacing, no terminal
+    replayMode = true;
+    arena_binding() = &consoleArena;
+    rng_set_seed(BENCH_SEED);
+
+    cout << "# gamehub-bench batches " << batches << " batch_ms " << batchMs << "\n"
+         << "# kernel median_ns fastest_ns ops_per_batch check\n";
+    for (BenchKernel& kernel : bench_kernels()) {
+        if (!filter.empty() && string_view(kernel.name).find(filter) == string_view::npos) continue;
+        BenchResult r = bench_run(kernel, batches, batchMs);
+        cout << kernel.name << " " << fixed << setprecision(2) << r.medianNs << " " << r.fastestNs << " " << r.ops
+             << " " << hex << setw(16) << setfill('0') << r.check << dec << setfill(' ') << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,407 @@
+/**
+ * ======================================================================================
+ * DICE ENGINE
+ * Headless dice kernels shared by the interactive simulator and the batch modes.
+ * ======================================================================================
+ */
+
+#ifndef GAMEHUB_DICE_H
+#define GAMEHUB_DICE_H
+
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "rng.h"
+
+// The AVX2 kernels are compiled with a per-function target attribute and picked at
+// runtime, so the binary still runs on CPUs without AVX2 and needs no extra flags.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GAMEHUB_DICE_AVX2 1
+#include <immintrin.h>
+#endif
+
+struct DiceRoll {
+    int d1;
+    int d2;
+};
+
+inline DiceRoll roll_dice(Rng& rng) {
+    int d1 = rng.range(1, 6);
+    int d2 = rng.range(1, 6);
+    return { d1, d2 };
+}
+
+inline bool is_doubles(const DiceRoll& roll) {
+    return roll.d1 == roll.d2;
+}
+
+// --- BATCH MONTE CARLO ENGINE ---
+// Rolls two d6 in bulk and tallies the doubles count and the sum histogram. Each
+// 64-bit RNG output yields both dice: die = (u32 * 6) >> 32 (Lemire), and the rare
+// draws whose low product half falls under 2^32 mod 6 = 4 are re-rolled, so the
+// result is exactly uniform rather than merely "close enough".
+
+struct DiceBatchStats {
+    std::uint64_t rolls = 0, doubles = 0;
+    std::uint64_t sums[13] = {};
+    void merge(const DiceBatchStats& o) {
+        rolls += o.rolls; doubles += o.doubles;
+        for (int i = 0; i < 13; i++) sums[i] += o.sums[i];
+    }
+};
+
+const std::uint32_t DICE_REJECT_BELOW = 4;    // (2^32 - 6) % 6
+
+// Tallies one roll from a 64-bit draw; falls back to rng.below() on rejection.
+inline void dice_tally_draw(Rng& rng, std::uint64_t r, std::uint64_t pairs[36]) {
+    std::uint64_t p1 = (r >> 32) * 6;
+    std::uint64_t p2 = (r & 0xFFFFFFFFull) * 6;
+    if (static_cast<std::uint32_t>(p1) < DICE_REJECT_BELOW || static_cast<std::uint32_t>(p2) < DICE_REJECT_BELOW) {
+        pairs[rng.below(6) * 6 + rng.below(6)]++;
+        return;
+    }
+    pairs[(p1 >> 32) * 6 + (p2 >> 32)]++;
+}
+
+inline void dice_fold_pairs(const std::uint64_t pairs[36], DiceBatchStats& out) {
+    for (int d1 = 0; d1 < 6; d1++) {
+        for (int d2 = 0; d2 < 6; d2++) {
+            std::uint64_t n = pairs[d1 * 6 + d2];
+            out.rolls += n;
+            out.sums[d1 + d2 + 2] += n;
+            if (d1 == d2) out.doubles += n;
+        }
+    }
+}
+
+inline void dice_batch_scalar(Rng& rng, std::uint64_t rolls, DiceBatchStats& out) {
+    std::uint64_t pairs[36] = {};
+    for (std::uint64_t i = 0; i < rolls; i++) dice_tally_draw(rng, rng.next(), pairs);
+    dice_fold_pairs(pairs, out);
+}
+
+#ifdef GAMEHUB_DICE_AVX2
+
+// Four xoshiro256** lanes stepped in lock-step; same recurrence as Rng::next().
+struct DiceAvx2Lanes {
+    __m256i s0, s1, s2, s3;
+};
+
+__attribute__((target("avx2"))) inline __m256i dice_avx2_next(DiceAvx2Lanes& l) {
+    __m256i x5 = _mm256_add_epi64(_mm256_slli_epi64(l.s1, 2), l.s1);
+    __m256i rot = _mm256_or_si256(_mm256_slli_epi64(x5, 7), _mm256_srli_epi64(x5, 57));
+    __m256i result = _mm256_add_epi64(_mm256_slli_epi64(rot, 3), rot);
+    __m256i t = _mm256_slli_epi64(l.s1, 17);
+    l.s2 = _mm256_xor_si256(l.s2, l.s0);
+    l.s3 = _mm256_xor_si256(l.s3, l.s1);
+    l.s1 = _mm256_xor_si256(l.s1, l.s2);
+    l.s0 = _mm256_xor_si256(l.s0, l.s3);
+    l.s2 = _mm256_xor_si256(l.s2, t);
+    l.s3 = _mm256_or_si256(_mm256_slli_epi64(l.s3, 45), _mm256_srli_epi64(l.s3, 19));
+    return result;
+}
+
+// Rolls 4 pairs from one vector of draws. The histogram is bit-packed: each 64-bit
+// lane holds twelve 5-bit counters (sums 2-12 at bits 0-54, doubles at bit 55), and
+// a roll adds 1 << (5 * sumIndex) with one variable shift. Counters are drained to
+// 64-bit totals before any of them can reach 32. On a rejected draw the whole vector
+// is re-rolled on the scalar path instead.
+__attribute__((target("avx2"))) inline void dice_avx2_roll(Rng& rng, __m256i r, __m256i& packed, std::uint64_t pairs[36]) {
+    const __m256i six = _mm256_set1_epi64x(6);
+    const __m256i one = _mm256_set1_epi64x(1);
+    const __m256i rejectMask = _mm256_set1_epi64x(0xFFFFFFFCll);
+    const __m256i doublesBit = _mm256_set1_epi64x(1ll << 55);
+
+    __m256i pe = _mm256_mul_epu32(r, six);
+    __m256i po = _mm256_mul_epu32(_mm256_srli_epi64(r, 32), six);
+    __m256i rejected = _mm256_or_si256(
+        _mm256_cmpeq_epi64(_mm256_and_si256(pe, rejectMask), _mm256_setzero_si256()),
+        _mm256_cmpeq_epi64(_mm256_and_si256(po, rejectMask), _mm256_setzero_si256()));
+    if (!_mm256_testz_si256(rejected, rejected)) {
+        for (int i = 0; i < 4; i++) pairs[rng.below(6) * 6 + rng.below(6)]++;
+        return;
+    }
+
+    __m256i d1 = _mm256_srli_epi64(pe, 32);
+    __m256i d2 = _mm256_srli_epi64(po, 32);
+    __m256i sum = _mm256_add_epi64(d1, d2);
+    __m256i shift = _mm256_add_epi64(_mm256_slli_epi64(sum, 2), sum);
+    packed = _mm256_add_epi64(packed, _mm256_sllv_epi64(one, shift));
+    packed = _mm256_add_epi64(packed, _mm256_and_si256(_mm256_cmpeq_epi64(d1, d2), doublesBit));
+}
+
+__attribute__((target("avx2"))) inline void dice_avx2_drain(__m256i packed, DiceBatchStats& out) {
+    alignas(32) std::uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), packed);
+    for (std::uint64_t lane : lanes) {
+        for (int s = 0; s < 11; s++) out.sums[s + 2] += (lane >> (5 * s)) & 31;
+        out.doubles += (lane >> 55) & 31;
+    }
+}
+
+__attribute__((target("avx2"))) inline void dice_batch_avx2(Rng& rng, std::uint64_t rolls, DiceBatchStats& out) {
+    // Two independent lane sets (8 streams) keep both vector pipes busy.
+    alignas(32) std::uint64_t seed[8][4];
+    for (auto& lane : seed) for (std::uint64_t& word : lane) word = rng.next();
+    DiceAvx2Lanes a = { _mm256_load_si256(reinterpret_cast<__m256i*>(seed[0])), _mm256_load_si256(reinterpret_cast<__m256i*>(seed[1])),
+                        _mm256_load_si256(reinterpret_cast<__m256i*>(seed[2])), _mm256_load_si256(reinterpret_cast<__m256i*>(seed[3])) };
+    DiceAvx2Lanes b = { _mm256_load_si256(reinterpret_cast<__m256i*>(seed[4])), _mm256_load_si256(reinterpret_cast<__m256i*>(seed[5])),
+                        _mm256_load_si256(reinterpret_cast<__m256i*>(seed[6])), _mm256_load_si256(reinterpret_cast<__m256i*>(seed[7])) };
+
+    const int DRAIN_EVERY = 31;     // 5-bit counters, at most +1 per step
+    std::uint64_t pairs[36] = {};   // Only touched by re-rolled vectors and the tail
+    std::uint64_t blocks = rolls / 8;
+    std::uint64_t vectorRolls = 0;
+
+    while (blocks > 0) {
+        std::uint64_t steps = blocks < DRAIN_EVERY ? blocks : DRAIN_EVERY;
+        __m256i packedA = _mm256_setzero_si256();
+        __m256i packedB = _mm256_setzero_si256();
+        for (std::uint64_t i = 0; i < steps; i++) {
+            dice_avx2_roll(rng, dice_avx2_next(a), packedA, pairs);
+            dice_avx2_roll(rng, dice_avx2_next(b), packedB, pairs);
+        }
+        dice_avx2_drain(packedA, out);
+        dice_avx2_drain(packedB, out);
+        blocks -= steps;
+        vectorRolls += steps * 8;
+    }
+
+    // Re-rolled vectors were tallied into `pairs`; count only what the packed path saw.
+    std::uint64_t rerolled = 0;
+    for (std::uint64_t n : pairs) rerolled += n;
+    out.rolls += vectorRolls - rerolled;
+
+    for (std::uint64_t i = vectorRolls; i < rolls; i++) dice_tally_draw(rng, rng.next(), pairs);
+    dice_fold_pairs(pairs, out);
+}
+
+#endif
+
+// Runtime kernel switch; --no-simd forces the scalar path for A/B comparisons.
+inline bool& dice_simd_enabled() {
+    static bool enabled = true;
+    return enabled;
+}
+
+inline bool dice_use_avx2() {
+#ifdef GAMEHUB_DICE_AVX2
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported && dice_simd_enabled();
+#else
+    return false;
+#endif
+}
+
+inline const char* dice_kernel_name() {
+    return dice_use_avx2() ? "AVX2" : "scalar";
+}
+
+inline void dice_batch(Rng& rng, std::uint64_t rolls, DiceBatchStats& out) {
+#ifdef GAMEHUB_DICE_AVX2
+    if (dice_use_avx2()) { dice_batch_avx2(rng, rolls, out); return; }
+#endif
+    dice_batch_scalar(rng, rolls, out);
+}
+
+// --- EXACT DISTRIBUTION ENGINE ---
+// The sum of N fair K-sided dice has generating function (x + ... + x^K)^N / K^N.
+// It is raised to the N-th power by repeated squaring, with a direct convolution
+// for short polynomials and an FFT once both factors are long. Coefficients are kept
+// as probabilities (each factor sums to 1), so nothing overflows. FFT products are
+// only accurate to a small multiple of 1e-16 times their peak, so coefficients under
+// 1e-12 of the peak are flushed to zero instead of piling up in the tails. Tail
+// queries on the largest inputs (10^6 outcomes) are therefore good to ~1e-11
+// absolute; direct-convolution sizes are exact to rounding. Results are cached per
+// (N, K).
+
+struct DiceDistribution {
+    int dice = 0;
+    int sides = 0;
+    std::vector<double> pmf;    // pmf[i]  = P(sum == dice + i)
+    std::vector<double> tail;   // tail[i] = P(sum >= dice + i), one extra 0 at the end
+
+    int min_sum() const { return dice; }
+    int max_sum() const { return dice * sides; }
+
+    double p_sum(int sum) const {
+        if (sum < min_sum() || sum > max_sum()) return 0;
+        return pmf[sum - dice];
+    }
+
+    double p_at_least(int t) const {
+        if (t <= min_sum()) return 1;
+        if (t > max_sum()) return 0;
+        return tail[t - dice];
+    }
+
+    // All N dice showing the same face: K outcomes out of K^N.
+    double p_all_equal() const {
+        return std::exp((1.0 - dice) * std::log(static_cast<double>(sides)));
+    }
+};
+
+const std::size_t DICE_FFT_CUTOFF = 64;    // Below this, direct O(nm) convolution is faster
+const double DICE_FFT_NOISE = 1e-12;       // Relative to the largest coefficient
+
+inline void dice_fft(std::vector<std::complex<double>>& a, bool inverse) {
+    const std::size_t n = a.size();
+    for (std::size_t i = 1, j = 0; i < n; i++) {
+        std::size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) std::swap(a[i], a[j]);
+    }
+    const double PI = 3.14159265358979323846;
+    for (std::size_t len = 2; len <= n; len <<= 1) {
+        double angle = 2 * PI / static_cast<double>(len) * (inverse ? -1 : 1);
+        std::complex<double> step(std::cos(angle), std::sin(angle));
+        for (std::size_t i = 0; i < n; i += len) {
+            std::complex<double> w(1);
+            for (std::size_t k = 0; k < len / 2; k++) {
+                std::complex<double> u = a[i + k], v = a[i + k + len / 2] * w;
+                a[i + k] = u + v;
+                a[i + k + len / 2] = u - v;
+                w *= step;
+            }
+        }
+    }
+    if (inverse) for (std::complex<double>& x : a) x /= static_cast<double>(n);
+}
+
+inline std::vector<double> dice_convolve(const std::vector<double>& a, const std::vector<double>& b) {
+    std::size_t outLen = a.size() + b.size() - 1;
+    std::vector<double> out(outLen, 0.0);
+
+    if (std::min(a.size(), b.size()) < DICE_FFT_CUTOFF) {
+        for (std::size_t i = 0; i < a.size(); i++)
+            for (std::size_t j = 0; j < b.size(); j++) out[i + j] += a[i] * b[j];
+        return out;
+    }
+
+    std::size_t n = 1;
+    while (n < outLen) n <<= 1;
+    bool square = (&a == &b);
+    std::vector<std::complex<double>> fa(a.begin(), a.end()), fb;
+    fa.resize(n);
+    dice_fft(fa, false);
+    if (square) {
+        for (std::complex<double>& x : fa) x *= x;
+    } else {
+        fb.assign(b.begin(), b.end());
+        fb.resize(n);
+        dice_fft(fb, false);
+        for (std::size_t i = 0; i < n; i++) fa[i] *= fb[i];
+    }
+    dice_fft(fa, true);
+    double peak = 0;
+    for (std::size_t i = 0; i < outLen; i++) peak = std::max(peak, fa[i].real());
+    for (std::size_t i = 0; i < outLen; i++) {
+        double v = fa[i].real();
+        out[i] = (v > peak * DICE_FFT_NOISE) ? v : 0.0;
+    }
+    return out;
+}
+
+inline std::shared_ptr<const DiceDistribution> build_dice_distribution(int dice, int sides) {
+    std::vector<double> result(1, 1.0);
+    std::vector<double> base(sides, 1.0 / sides);
+    for (int n = dice; n > 0; n >>= 1) {
+        if (n & 1) result = dice_convolve(result, base);
+        if (n > 1) base = dice_convolve(base, base);
+    }
+
+    auto dist = std::make_shared<DiceDistribution>();
+    dist->dice = dice;
+    dist->sides = sides;
+    dist->tail.assign(result.size() + 1, 0.0);
+    double total = 0;
+    for (std::size_t i = result.size(); i-- > 0; ) total += result[i];
+    for (std::size_t i = result.size(); i-- > 0; ) {
+        result[i] /= total;     // Renormalize away accumulated FFT drift
+        dist->tail[i] = dist->tail[i + 1] + result[i];
+    }
+    dist->pmf = std::move(result);
+    return dist;
+}
+
+// Finished tables kept for reuse; a 1000 x 1000 table alone is about 16 MB.
+constexpr std::size_t DICE_CACHE_BYTES = 64u << 20;
+
+// Recently used distributions, least recently used dropped first once over budget.
+// A table is built outside the lock: callers asking for the same one wait on its
+// future, everyone else carries on. Dropped tables live on in callers that hold them.
+struct DiceCache {
+    using Result = std::shared_future<std::shared_ptr<const DiceDistribution>>;
+    struct Slot {
+        Result result;
+        std::size_t bytes = 0;      // 0 while being built; never evicted then
+        std::uint64_t used = 0;
+    };
+
+    std::mutex lock;
+    std::map<std::pair<int, int>, Slot> slots;
+    std::size_t bytes = 0;
+    std::uint64_t clock = 0;
+
+    void evict(const std::pair<int, int>& keep) {
+        while (bytes > DICE_CACHE_BYTES) {
+            auto oldest = slots.end();
+            for (auto it = slots.begin(); it != slots.end(); ++it) {
+                if (it->first == keep || it->second.bytes == 0) continue;
+                if (oldest == slots.end() || it->second.used < oldest->second.used) oldest = it;
+            }
+            if (oldest == slots.end()) return;
+            bytes -= oldest->second.bytes;
+            slots.erase(oldest);
+        }
+    }
+};
+
+// Cached lookup, safe to call from any thread. Expects dice >= 1 and sides >= 1.
+inline std::shared_ptr<const DiceDistribution> dice_distribution(int dice, int sides) {
+    static DiceCache cache;
+    const std::pair<int, int> key(dice, sides);
+
+    std::unique_lock<std::mutex> guard(cache.lock);
+    auto found = cache.slots.find(key);
+    if (found != cache.slots.end()) {
+        found->second.used = ++cache.clock;
+        DiceCache::Result result = found->second.result;
+        guard.unlock();         // Wait for a table still being built without the lock
+        return result.get();
+    }
+    std::promise<std::shared_ptr<const DiceDistribution>> building;
+    DiceCache::Slot& fresh = cache.slots[key];
+    fresh.result = building.get_future().share();
+    fresh.used = ++cache.clock;
+    guard.unlock();
+
+    std::shared_ptr<const DiceDistribution> dist;
+    try {
+        dist = build_dice_distribution(dice, sides);
+    } catch (...) {
+        building.set_exception(std::current_exception());
+        guard.lock();
+        cache.slots.erase(key);     // The next caller tries again
+        throw;
+    }
+    building.set_value(dist);
+
+    guard.lock();
+    DiceCache::Slot& slot = cache.slots[key];
+    slot.bytes = (dist->pmf.size() + dist->tail.size()) * sizeof(double);
+    cache.bytes += slot.bytes;
+    cache.evict(key);
+    return dist;
+}
+
+#endif
@@ -0,0 +1,240 @@
+/**
+ * ======================================================================================
+ * EVENT LOOP
+ * Timer-driven pacing and animation for the single UI thread. Instead of blocking in
+ * sleep_for, the loop waits on "next timer deadline OR input readable", so a keypress
+ * cancels an animation immediately and the typed input is left for the next prompt.
+ * Also home to the raw keyboard backend the prompts read keystrokes from.
+ * ======================================================================================
+ */
+
+#ifndef GAMEHUB_EVENTS_H
+#define GAMEHUB_EVENTS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <csignal>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+// Waits up to timeoutMs (0 = just check) for the player to send input. Also true at
+// end-of-file, since a closed stdin will never block the next read either.
+inline bool input_ready(int timeoutMs) {
+#ifdef _WIN32
+    HANDLE in = GetStdHandle(STD_INPUT_HANDLE);
+    if (GetFileType(in) != FILE_TYPE_CHAR) {
+        // Pipe or file: poll the byte count until the timeout runs out
+        auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        while (true) {
+            DWORD avail = 0;
+            if (!PeekNamedPipe(in, nullptr, 0, nullptr, &avail, nullptr) || avail > 0) return true;
+            if (std::chrono::steady_clock::now() >= end) return false;
+            Sleep(1);
+        }
+    }
+    // Console: the handle is signalled for any event; only key presses count
+    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (true) {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(end - std::chrono::steady_clock::now()).count();
+        if (WaitForSingleObject(in, left > 0 ? static_cast<DWORD>(left) : 0) != WAIT_OBJECT_0) return false;
+        INPUT_RECORD record;
+        DWORD count = 0;
+        if (!PeekConsoleInputA(in, &record, 1, &count) || count == 0) return false;
+        if (record.EventType == KEY_EVENT && record.Event.KeyEvent.bKeyDown) return true;
+        ReadConsoleInputA(in, &record, 1, &count);  // Drop focus/mouse/key-up noise
+    }
+#else
+    struct pollfd pfd = { STDIN_FILENO, POLLIN, 0 };
+    return poll(&pfd, 1, timeoutMs) > 0;
+#endif
+}
+
+class EventLoop {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // One-shot timer, `ms` from now. Timers due at the same instant fire in the order
+    // they were added.
+    void after(int ms, std::function<void()> fire) {
+        timers.push_back({ Clock::now() + std::chrono::milliseconds(ms), sequence++, std::move(fire) });
+        std::push_heap(timers.begin(), timers.end(), Later());
+    }
+
+    void cancel_all() { timers.clear(); }
+    bool idle() const { return timers.empty(); }
+
+    // Fires timers in deadline order until none are left. When `interruptible`, input
+    // arriving in between cancels the remaining timers and returns true at once.
+    bool run(bool interruptible = true) {
+        while (!timers.empty()) {
+            Clock::time_point now = Clock::now();
+            if (timers.front().deadline <= now) {
+                std::pop_heap(timers.begin(), timers.end(), Later());
+                Timer due = std::move(timers.back());
+                timers.pop_back();
+                due.fire();
+                continue;
+            }
+
+            auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(timers.front().deadline - now).count() + 1;
+            if (!interruptible) {
+                std::this_thread::sleep_until(timers.front().deadline);
+            } else if (input_ready(static_cast<int>(wait))) {
+                cancel_all();
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    struct Timer {
+        Clock::time_point deadline;
+        std::uint64_t order;
+        std::function<void()> fire;
+    };
+
+    struct Later {
+        bool operator()(const Timer& a, const Timer& b) const {
+            return a.deadline != b.deadline ? a.deadline > b.deadline : a.order > b.order;
+        }
+    };
+
+    std::vector<Timer> timers;      // Min-heap on (deadline, order)
+    std::uint64_t sequence = 0;
+};
+
+// The UI thread's loop.
+inline EventLoop& event_loop() {
+    static EventLoop loop;
+    return loop;
+}
+
+// --- KEYBOARD ---
+
+// Raw mode: no line discipline and no echo, so every keystroke reaches the game as
+// it is typed and the UI does its own echo. Ctrl+C still raises SIGINT.
+inline bool& raw_input_flag() {
+    static bool active = false;
+    return active;
+}
+
+inline bool raw_input_active() { return raw_input_flag(); }
+
+#ifdef _WIN32
+inline DWORD& raw_input_saved_mode() {
+    static DWORD mode = 0;
+    return mode;
+}
+
+inline void raw_input_end() {
+    if (!raw_input_flag()) return;
+    SetConsoleMode(GetStdHandle(STD_INPUT_HANDLE), raw_input_saved_mode());
+    raw_input_flag() = false;
+}
+
+// False (and nothing changes) when stdin is not a console.
+inline bool raw_input_begin() {
+    if (raw_input_flag()) return true;
+    HANDLE in = GetStdHandle(STD_INPUT_HANDLE);
+    DWORD mode = 0;
+    if (GetFileType(in) != FILE_TYPE_CHAR || !GetConsoleMode(in, &mode)) return false;
+    if (!SetConsoleMode(in, mode & ~static_cast<DWORD>(ENABLE_LINE_INPUT | ENABLE_ECHO_INPUT))) return false;
+    raw_input_saved_mode() = mode;
+    raw_input_flag() = true;
+    std::atexit(raw_input_end);
+    return true;
+}
+
+// Next keystroke, blocking. False at end of input (Ctrl+Z).
+inline bool read_key(char& key) {
+    DWORD count = 0;
+    if (!ReadConsoleA(GetStdHandle(STD_INPUT_HANDLE), &key, 1, &count, nullptr) || count == 0) return false;
+    return key != 0x1a;
+}
+#else
+inline termios& raw_input_saved_mode() {
+    static termios mode;
+    return mode;
+}
+
+inline void raw_input_end() {
+    if (!raw_input_flag()) return;
+    tcsetattr(STDIN_FILENO, TCSAFLUSH, &raw_input_saved_mode());
+    raw_input_flag() = false;
+}
+
+// Killed mid-game: hand the shell back a sane terminal, then die as asked.
+inline void raw_input_on_signal(int sig) {
+    tcsetattr(STDIN_FILENO, TCSAFLUSH, &raw_input_saved_mode());
+    std::signal(sig, SIG_DFL);
+    std::raise(sig);
+}
+
+// False (and nothing changes) when stdin is not a terminal.
+inline bool raw_input_begin() {
+    if (raw_input_flag()) return true;
+    termios mode;
+    if (!isatty(STDIN_FILENO) || tcgetattr(STDIN_FILENO, &mode) != 0) return false;
+    raw_input_saved_mode() = mode;
+
+    mode.c_lflag &= ~static_cast<tcflag_t>(ICANON | ECHO);
+    mode.c_cc[VMIN] = 1;
+    mode.c_cc[VTIME] = 0;
+    if (tcsetattr(STDIN_FILENO, TCSAFLUSH, &mode) != 0) return false;
+
+    raw_input_flag() = true;
+    std::atexit(raw_input_end);
+    std::signal(SIGINT, raw_input_on_signal);
+    std::signal(SIGTERM, raw_input_on_signal);
+    std::signal(SIGHUP, raw_input_on_signal);
+    return true;
+}
+
+inline bool read_byte(char& byte) {
+    while (true) {
+        ssize_t n = ::read(STDIN_FILENO, &byte, 1);
+        if (n == 1) return true;
+        if (n < 0 && errno == EINTR) continue;
+        return false;
+    }
+}
+
+// Next keystroke, blocking. False at end of input. Escape sequences (arrows, function
+// keys) have no meaning in the menus and are swallowed whole.
+inline bool read_key(char& key) {
+    while (true) {
+        if (!read_byte(key)) return false;
+        if (key != '\x1b') return true;
+
+        // A lone Escape arrives alone; a sequence arrives as one burst
+        char next;
+        if (!input_ready(10) || !read_byte(next)) continue;
+        if (next == 'O') {
+            read_byte(next);
+        } else if (next == '[') {
+            do {
+                if (!read_byte(next)) return false;
+            } while (next < 0x40 || next > 0x7e);
+        }
+    }
+}
+#endif
+
+#endif
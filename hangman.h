@@ -0,0 +1,697 @@
+/**
+ * ======================================================================================
+ * HANGMAN DICTIONARY
+ * Word lists of any size with no per-word allocations: the list is memory-mapped as-is
+ * and a side index (<list>.idx) holds one fixed-size record per word, sorted into
+ * (difficulty, length) buckets, so a pick is one bounded random draw. A game in
+ * progress is a handful of bitmasks, so guesses and the win test are bit operations.
+ * The CPU solver works on a column-major copy, refining its candidates after each guess.
+ * ======================================================================================
+ */
+
+#ifndef GAMEHUB_HANGMAN_H
+#define GAMEHUB_HANGMAN_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+#include "mapfile.h"
+#include "rng.h"
+
+// The filter kernel is compiled for AVX2 per function and picked at runtime, as the
+// dice kernels are; the scalar loop is the reference and the fallback.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GAMEHUB_HANGMAN_AVX2 1
+#include <immintrin.h>
+#endif
+
+enum HangmanDifficulty { HANGMAN_EASY, HANGMAN_MEDIUM, HANGMAN_HARD, HANGMAN_LEVELS };
+
+constexpr int HANGMAN_ANY = -1;
+constexpr int HANGMAN_MAX_LEN = 31;     // Longer lines are not indexed
+
+// One indexed word. `offset` points into the mapped list; the word itself is never copied.
+struct HangmanEntry {
+    std::uint32_t offset;
+    std::uint8_t length;
+    std::uint8_t difficulty;
+    std::uint16_t reserved;
+    std::uint32_t mask;             // Bit i set when letter 'A' + i occurs
+};
+static_assert(sizeof(HangmanEntry) == 12, "index records are written to disk as-is");
+
+// Index file layout: this header, then `count` entries. bucket[d][len] is the first
+// entry with (difficulty, length) >= (d, len); bucket[d][HANGMAN_MAX_LEN + 1] ends level d.
+struct HangmanIndexHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t sourceSize;
+    std::int64_t sourceTime;
+    std::uint32_t count;
+    std::uint32_t reserved;
+    std::uint32_t bucket[HANGMAN_LEVELS][HANGMAN_MAX_LEN + 2];
+};
+
+constexpr std::uint32_t HANGMAN_INDEX_VERSION = 1;
+
+inline std::uint32_t hangman_mask(std::string_view word) {
+    std::uint32_t mask = 0;
+    for (char c : word) mask |= 1u << ((c | 0x20) - 'a');
+    return mask;
+}
+
+// Misses a player guessing in English letter-frequency order takes to finish the word.
+// Easy words are ones that player survives on six lives; rare letters push it up.
+inline int hangman_difficulty(std::uint32_t mask) {
+    static constexpr char ORDER[] = "ETAOINSHRDLCUMWFGYPBVKJXQZ";
+    int misses = 0;
+    for (int i = 0; mask != 0; i++) {
+        std::uint32_t bit = 1u << (ORDER[i] - 'A');
+        if (mask & bit) mask &= ~bit;
+        else misses++;
+    }
+    return misses <= 5 ? HANGMAN_EASY : misses <= 11 ? HANGMAN_MEDIUM : HANGMAN_HARD;
+}
+
+// Used when no --dict is given (or it cannot be read).
+constexpr char HANGMAN_BUILTIN_WORDS[] =
+    "PROGRAMMING\nCOMPUTER\nKEYBOARD\nDEVELOPER\nALGORITHM\nVARIABLE\nPOINTER\n"
+    "THREAD\nHANDLER\nCONTAINER\nITERATOR\nINTERNET\nASSERTION\n"
+    "TERMINAL\nCONSOLE\nCOMPILER\nRENDERING\n"
+    "DATABASE\nDEBUGGER\nSYNTAX\nBUFFER\n";
+
+class HangmanDictionary {
+public:
+    HangmanDictionary() { use_builtin(); }
+    HangmanDictionary(const HangmanDictionary&) = delete;
+    HangmanDictionary& operator=(const HangmanDictionary&) = delete;
+
+    // Maps a word list (one word per line, letters only; other lines are skipped)
+    // and its index, rebuilding <path>.idx when it is missing or older than the list.
+    // On failure the current dictionary stays in place.
+    bool load(const std::string& path, std::string& error) {
+        std::error_code ec;
+        std::uint64_t sourceSize = std::filesystem::file_size(path, ec);
+        if (ec) { error = "cannot read " + path; return false; }
+        std::int64_t sourceTime = std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+        if (ec) sourceTime = 0;
+        if (sourceSize > UINT32_MAX) { error = path + " is larger than 4 GiB"; return false; }
+
+        MappedFile newSource;
+        if (!newSource.open(path)) { error = "cannot map " + path; return false; }
+
+        std::string indexPath = path + ".idx";
+        MappedFile newIndex;
+        if (newIndex.open(indexPath) && index_matches(newIndex, newSource, sourceSize, sourceTime)) {
+            adopt(newSource, &newIndex);
+        } else {
+            adopt(newSource, nullptr);
+            header.sourceSize = sourceSize;
+            header.sourceTime = sourceTime;
+            save_index(indexPath);  // Best effort: a read-only directory just means rebuilding next time
+        }
+
+        if (size() == 0) {
+            use_builtin();
+            error = path + " has no usable words";
+            return false;
+        }
+        return true;
+    }
+
+    void use_builtin() {
+        source.close();
+        index.close();
+        text = HANGMAN_BUILTIN_WORDS;
+        textSize = sizeof(HANGMAN_BUILTIN_WORDS) - 1;
+        build();
+    }
+
+    std::size_t size() const { return header.count; }
+
+    // Words of `difficulty` (or HANGMAN_ANY) with length in [minLen, maxLen].
+    std::size_t count(int difficulty, int minLen, int maxLen) const {
+        std::size_t n = 0;
+        for (int d = 0; d < HANGMAN_LEVELS; d++) {
+            if (difficulty == HANGMAN_ANY || difficulty == d) n += bucket_end(d, maxLen) - bucket_begin(d, minLen);
+        }
+        return n;
+    }
+
+    // Uniform pick among the matching words, or nullptr when there are none.
+    const HangmanEntry* pick(Rng& rng, int difficulty, int minLen = 1, int maxLen = HANGMAN_MAX_LEN) const {
+        std::size_t n = count(difficulty, minLen, maxLen);
+        if (n == 0) return nullptr;
+        std::uint32_t k = rng.below(static_cast<std::uint32_t>(n));
+        for (int d = 0; d < HANGMAN_LEVELS; d++) {
+            if (difficulty != HANGMAN_ANY && difficulty != d) continue;
+            std::uint32_t begin = bucket_begin(d, minLen), end = bucket_end(d, maxLen);
+            if (k < end - begin) return &entries[begin + k];
+            k -= end - begin;
+        }
+        return nullptr;
+    }
+
+    // Entries in index order, for whole-list passes.
+    const HangmanEntry& entry(std::size_t i) const { return entries[i]; }
+
+    // The word as it appears in the list (case as written).
+    std::string_view word(const HangmanEntry& e) const {
+        return std::string_view(text + e.offset, e.length);
+    }
+
+private:
+    std::uint32_t bucket_begin(int d, int minLen) const {
+        return header.bucket[d][clamp_len(minLen)];
+    }
+    std::uint32_t bucket_end(int d, int maxLen) const {
+        return header.bucket[d][clamp_len(maxLen) + 1];
+    }
+    static int clamp_len(int len) {
+        return len < 0 ? 0 : len > HANGMAN_MAX_LEN ? HANGMAN_MAX_LEN : len;
+    }
+
+    // The stamp says the index was built from this list; the walk makes sure it is
+    // one build() could have written for the bytes mapped now, so no bucket or entry
+    // reaches past either file and every word is still the letters its mask records.
+    // A list rewritten in place under the same size and mtime fails here and is rebuilt.
+    static bool index_matches(const MappedFile& file, const MappedFile& source, std::uint64_t sourceSize, std::int64_t sourceTime) {
+        if (file.size() < sizeof(HangmanIndexHeader)) return false;
+        HangmanIndexHeader h;
+        std::memcpy(&h, file.data(), sizeof h);
+        if (std::memcmp(h.magic, "HGIX", 4) != 0 || h.version != HANGMAN_INDEX_VERSION ||
+            h.sourceSize != sourceSize || h.sourceTime != sourceTime ||
+            file.size() != sizeof h + std::size_t(h.count) * sizeof(HangmanEntry)) {
+            return false;
+        }
+
+        // Buckets tile [0, count) in (difficulty, length) order, and each entry sits
+        // in its own bucket, inside the list, over the word it was made from
+        const char* records = file.data() + sizeof h;
+        std::uint32_t at = 0;
+        for (int d = 0; d < HANGMAN_LEVELS; d++) {
+            if (h.bucket[d][0] != at) return false;
+            for (int len = 0; len <= HANGMAN_MAX_LEN; len++) {
+                std::uint32_t end = h.bucket[d][len + 1];
+                if (end < at || end > h.count) return false;
+                for (; at < end; at++) {
+                    HangmanEntry e;
+                    std::memcpy(&e, records + std::size_t(at) * sizeof e, sizeof e);
+                    if (e.difficulty != d || e.length != len || len == 0 ||
+                        std::uint64_t(e.offset) + e.length > source.size() ||
+                        !letters_match(std::string_view(source.data() + e.offset, e.length), e.mask)) {
+                        return false;
+                    }
+                }
+            }
+        }
+        return at == h.count;
+    }
+
+    static bool letters_match(std::string_view word, std::uint32_t mask) {
+        for (char c : word) {
+            char lower = c | 0x20;
+            if (lower < 'a' || lower > 'z') return false;
+        }
+        return hangman_mask(word) == mask;
+    }
+
+    // Takes over a mapped list, with its mapped index or (nullptr) a freshly built one.
+    void adopt(MappedFile& newSource, MappedFile* newIndex) {
+        source.close();
+        index.close();
+        source.swap(newSource);
+        text = source.data();
+        textSize = source.size();
+        if (newIndex) {
+            index.swap(*newIndex);
+            std::memcpy(&header, index.data(), sizeof header);
+            entries = reinterpret_cast<const HangmanEntry*>(index.data() + sizeof header);
+            built.clear();
+            built.shrink_to_fit();
+        } else {
+            build();
+        }
+    }
+
+    // One pass to collect records, then a counting sort into (difficulty, length) order.
+    void build() {
+        std::vector<HangmanEntry> scanned;
+        std::uint32_t counts[HANGMAN_LEVELS][HANGMAN_MAX_LEN + 2] = {};
+
+        std::size_t pos = 0;
+        while (pos < textSize) {
+            const char* line = text + pos;
+            const void* nl = std::memchr(line, '\n', textSize - pos);
+            std::size_t len = nl ? static_cast<const char*>(nl) - line : textSize - pos;
+            std::size_t next = pos + len + 1;
+            if (len > 0 && line[len - 1] == '\r') len--;
+
+            bool letters = len > 0 && len <= static_cast<std::size_t>(HANGMAN_MAX_LEN);
+            for (std::size_t i = 0; letters && i < len; i++) {
+                char c = line[i] | 0x20;
+                letters = c >= 'a' && c <= 'z';
+            }
+            if (letters) {
+                std::uint32_t mask = hangman_mask(std::string_view(line, len));
+                HangmanEntry e = { static_cast<std::uint32_t>(pos), static_cast<std::uint8_t>(len),
+                                   static_cast<std::uint8_t>(hangman_difficulty(mask)), 0, mask };
+                scanned.push_back(e);
+                counts[e.difficulty][e.length]++;
+            }
+            pos = next;
+        }
+
+        std::memset(&header, 0, sizeof header);
+        std::memcpy(header.magic, "HGIX", 4);
+        header.version = HANGMAN_INDEX_VERSION;
+        header.count = static_cast<std::uint32_t>(scanned.size());
+
+        std::uint32_t start = 0;
+        for (int d = 0; d < HANGMAN_LEVELS; d++) {
+            for (int len = 0; len <= HANGMAN_MAX_LEN + 1; len++) {
+                header.bucket[d][len] = start;
+                if (len <= HANGMAN_MAX_LEN) start += counts[d][len];
+            }
+        }
+
+        built.resize(scanned.size());
+        std::uint32_t fill[HANGMAN_LEVELS][HANGMAN_MAX_LEN + 1];
+        for (int d = 0; d < HANGMAN_LEVELS; d++) {
+            for (int len = 0; len <= HANGMAN_MAX_LEN; len++) fill[d][len] = header.bucket[d][len];
+        }
+        for (const HangmanEntry& e : scanned) built[fill[e.difficulty][e.length]++] = e;
+        entries = built.data();
+    }
+
+    void save_index(const std::string& indexPath) const {
+        std::ofstream f(indexPath, std::ios::binary | std::ios::trunc);
+        if (!f) return;
+        f.write(reinterpret_cast<const char*>(&header), sizeof header);
+        f.write(reinterpret_cast<const char*>(entries), std::streamsize(header.count) * sizeof(HangmanEntry));
+        if (!f) {
+            f.close();
+            std::error_code ec;
+            std::filesystem::remove(indexPath, ec);
+        }
+    }
+
+    MappedFile source, index;
+    const char* text = nullptr;
+    std::size_t textSize = 0;
+    HangmanIndexHeader header = {};
+    const HangmanEntry* entries = nullptr;
+    std::vector<HangmanEntry> built;    // Backing store when the index was built in memory
+};
+
+// --- GAME STATE ---
+
+// A word prepared for play: which letters it holds, and for each letter the positions
+// it sits at (bit i = position i). Built once per game, in one pass over the word.
+struct HangmanWord {
+    std::uint32_t letters = 0;
+    std::uint32_t positions[26] = {};
+    int length = 0;
+};
+
+inline HangmanWord hangman_word(std::string_view word) {
+    HangmanWord w;
+    w.length = static_cast<int>(word.size());
+    for (int i = 0; i < w.length; i++) {
+        int letter = (word[i] | 0x20) - 'a';
+        w.positions[letter] |= 1u << i;
+        w.letters |= 1u << letter;
+    }
+    return w;
+}
+
+enum HangmanGuess { HANGMAN_REPEAT, HANGMAN_HIT, HANGMAN_MISS };
+
+struct HangmanGame {
+    HangmanWord word;
+    std::uint32_t guessed = 0;      // Letters tried so far
+    std::uint32_t revealed = 0;     // Positions uncovered so far
+    int lives = 6;
+};
+
+// `letter` is 0-25. Repeats cost nothing; misses cost a life.
+inline HangmanGuess hangman_guess(HangmanGame& g, int letter) {
+    std::uint32_t bit = 1u << letter;
+    if (g.guessed & bit) return HANGMAN_REPEAT;
+    g.guessed |= bit;
+    if (g.word.letters & bit) {
+        g.revealed |= g.word.positions[letter];
+        return HANGMAN_HIT;
+    }
+    g.lives--;
+    return HANGMAN_MISS;
+}
+
+inline bool hangman_solved(const HangmanGame& g) {
+    return (g.word.letters & ~g.guessed) == 0;
+}
+
+// --- SOLVER ---
+
+// Words of one length, column-major: letter p (0-25) of word i is at letters[p * stride + i].
+// The stride is a multiple of 32 so the filter can always load whole vectors.
+struct HangmanColumns {
+    int length = 0;
+    std::uint32_t count = 0;
+    std::uint32_t stride = 0;
+    std::vector<std::uint8_t> letters;
+};
+
+inline std::uint32_t hangman_stride(std::uint32_t count) {
+    return count == 0 ? 32 : (count + 31) & ~31u;
+}
+
+inline bool& hangman_simd_enabled() {
+    static bool enabled = true;
+    return enabled;
+}
+
+inline bool hangman_use_avx2() {
+#ifdef GAMEHUB_HANGMAN_AVX2
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported && hangman_simd_enabled();
+#else
+    return false;
+#endif
+}
+
+// keep[b] bit t is set when word 32b + t shows `letter` at exactly `positions` (0 for a miss).
+inline void hangman_match_scalar(const HangmanColumns& w, int letter, std::uint32_t positions, std::uint32_t* keep) {
+    std::uint32_t blocks = (w.count + 31) / 32;
+    for (std::uint32_t b = 0; b < blocks; b++) keep[b] = 0;
+    for (std::uint32_t i = 0; i < w.count; i++) {
+        bool ok = true;
+        for (int p = 0; ok && p < w.length; p++) {
+            ok = (w.letters[p * w.stride + i] == letter) == ((positions >> p & 1) != 0);
+        }
+        if (ok) keep[i / 32] |= 1u << (i % 32);
+    }
+}
+
+#ifdef GAMEHUB_HANGMAN_AVX2
+__attribute__((target("avx2"))) inline void hangman_match_avx2(const HangmanColumns& w, int letter, std::uint32_t positions, std::uint32_t* keep) {
+    const __m256i target = _mm256_set1_epi8(static_cast<char>(letter));
+    const std::uint8_t* base = w.letters.data();
+    std::uint32_t blocks = (w.count + 31) / 32;
+    for (std::uint32_t b = 0; b < blocks; b++) {
+        __m256i ok = _mm256_set1_epi8(-1);
+        for (int p = 0; p < w.length; p++) {
+            __m256i column = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(base + p * w.stride + b * 32));
+            __m256i eq = _mm256_cmpeq_epi8(column, target);
+            ok = (positions >> p & 1) ? _mm256_and_si256(ok, eq) : _mm256_andnot_si256(eq, ok);
+        }
+        keep[b] = static_cast<std::uint32_t>(_mm256_movemask_epi8(ok));
+    }
+    if (w.count % 32) keep[blocks - 1] &= (1u << (w.count % 32)) - 1;    // Padding rows
+}
+#endif
+
+inline void hangman_match(const HangmanColumns& w, int letter, std::uint32_t positions, std::uint32_t* keep) {
+#ifdef GAMEHUB_HANGMAN_AVX2
+    if (hangman_use_avx2()) { hangman_match_avx2(w, letter, positions, keep); return; }
+#endif
+    hangman_match_scalar(w, letter, positions, keep);
+}
+
+// Copies the kept rows of `src` into `dst`, which may be `src` itself: column by column,
+// every write lands at or before the read it came from, so nothing unread is clobbered.
+inline void hangman_compact(const HangmanColumns& src, const std::uint32_t* keep, std::uint32_t kept, HangmanColumns& dst) {
+    std::uint32_t stride = hangman_stride(kept);
+    std::uint32_t blocks = (src.count + 31) / 32;
+    if (&dst != &src) dst.letters.resize(std::size_t(src.length) * stride);
+    for (int p = 0; p < src.length; p++) {
+        const std::uint8_t* from = src.letters.data() + std::size_t(p) * src.stride;
+        std::uint8_t* to = dst.letters.data() + std::size_t(p) * stride;
+        std::uint32_t j = 0;
+        for (std::uint32_t b = 0; b < blocks; b++) {
+            for (std::uint32_t bits = keep[b]; bits; bits &= bits - 1) to[j++] = from[b * 32 + __builtin_ctz(bits)];
+        }
+    }
+    dst.length = src.length;
+    dst.count = kept;
+    dst.stride = stride;
+    if (&dst == &src) dst.letters.resize(std::size_t(dst.length) * stride);
+}
+
+// Reusable buffers for scoring, so a solver allocates nothing once warmed up. The
+// answer-class table is open addressing sized to the classes actually seen (far fewer
+// than words), and only the slots used are cleared between calls.
+struct HangmanScratch {
+    std::vector<std::uint64_t> keys;    // (letter << 32 | position mask) + 1; 0 = empty slot
+    std::vector<std::uint32_t> counts;
+    std::vector<std::uint32_t> used;
+    std::vector<std::uint32_t> keep;
+
+    void clear_classes() {
+        if (keys.empty()) { keys.assign(1024, 0); counts.assign(1024, 0); }
+        for (std::uint32_t slot : used) keys[slot] = 0;
+        used.clear();
+    }
+
+    void add_class(std::uint64_t key) {
+        if (used.size() * 2 >= keys.size()) grow();
+        std::size_t mask = keys.size() - 1;
+        std::size_t slot = (key * 0x9E3779B97F4A7C15ULL) >> 40 & mask;
+        while (keys[slot] != 0 && keys[slot] != key) slot = (slot + 1) & mask;
+        if (keys[slot] == 0) {
+            keys[slot] = key;
+            counts[slot] = 0;
+            used.push_back(static_cast<std::uint32_t>(slot));
+        }
+        counts[slot]++;
+    }
+
+private:
+    void grow() {
+        std::vector<std::uint64_t> oldKeys(keys.size() * 2, 0);
+        std::vector<std::uint32_t> oldCounts(keys.size() * 2, 0);
+        oldKeys.swap(keys);
+        oldCounts.swap(counts);
+        std::vector<std::uint32_t> oldUsed;
+        oldUsed.swap(used);
+        std::size_t mask = keys.size() - 1;
+        for (std::uint32_t from : oldUsed) {
+            std::size_t slot = (oldKeys[from] * 0x9E3779B97F4A7C15ULL) >> 40 & mask;
+            while (keys[slot] != 0) slot = (slot + 1) & mask;
+            keys[slot] = oldKeys[from];
+            counts[slot] = oldCounts[from];
+            used.push_back(static_cast<std::uint32_t>(slot));
+        }
+    }
+};
+
+// Letter whose answer (which positions it fills, if any) carries the most information
+// about the remaining words, i.e. minimizes sum(k log k) over answer classes. Ties go
+// to the letter more words contain. With no candidates left, plain frequency order.
+inline int hangman_best_letter(const HangmanColumns& w, std::uint32_t guessed, HangmanScratch& scratch) {
+    static constexpr char ORDER[] = "ETAOINSHRDLCUMWFGYPBVKJXQZ";
+    if (w.count == 0) {
+        for (int i = 0; i < 26; i++) if (!(guessed >> (ORDER[i] - 'A') & 1)) return ORDER[i] - 'A';
+        return 0;
+    }
+
+    scratch.clear_classes();
+    std::uint32_t hits[26] = {};
+
+    for (std::uint32_t i = 0; i < w.count; i++) {
+        std::uint32_t pattern[26];
+        std::uint32_t present = 0;
+        for (int p = 0; p < w.length; p++) {
+            int c = w.letters[p * w.stride + i];
+            std::uint32_t bit = 1u << c;
+            if (!(present & bit)) { present |= bit; pattern[c] = 0; }
+            pattern[c] |= 1u << p;
+        }
+        for (std::uint32_t open = present & ~guessed; open; open &= open - 1) {
+            int c = __builtin_ctz(open);
+            hits[c]++;
+            scratch.add_class((std::uint64_t(c) << 32 | pattern[c]) + 1);
+        }
+    }
+
+    double cost[26];
+    for (int c = 0; c < 26; c++) {
+        double misses = w.count - hits[c];
+        cost[c] = misses > 0 ? misses * std::log2(misses) : 0;
+    }
+    for (std::uint32_t slot : scratch.used) {
+        double k = scratch.counts[slot];
+        cost[(scratch.keys[slot] - 1) >> 32] += k * std::log2(k);
+    }
+
+    int best = -1;
+    for (int c = 0; c < 26; c++) {
+        if (guessed >> c & 1) continue;
+        if (best < 0 || cost[c] < cost[best] - 1e-9 || (cost[c] < cost[best] + 1e-9 && hits[c] > hits[best])) best = c;
+    }
+    return best;
+}
+
+// The dictionary regrouped into column blocks by length, plus the opening guess for
+// each length (the candidate set before any guess is always the whole block).
+class HangmanSolverIndex {
+public:
+    explicit HangmanSolverIndex(const HangmanDictionary& dict) {
+        std::uint32_t counts[HANGMAN_MAX_LEN + 1] = {};
+        for (std::size_t i = 0; i < dict.size(); i++) counts[dict.entry(i).length]++;
+        for (int len = 0; len <= HANGMAN_MAX_LEN; len++) {
+            HangmanColumns& w = byLength[len];
+            w.length = len;
+            w.stride = hangman_stride(counts[len]);
+            w.letters.assign(std::size_t(len) * w.stride, 0);
+        }
+        for (std::size_t i = 0; i < dict.size(); i++) {
+            const HangmanEntry& e = dict.entry(i);
+            HangmanColumns& w = byLength[e.length];
+            std::string_view word = dict.word(e);
+            for (int p = 0; p < w.length; p++) w.letters[p * w.stride + w.count] = static_cast<std::uint8_t>((word[p] | 0x20) - 'a');
+            w.count++;
+        }
+
+        HangmanScratch scratch;
+        for (int len = 0; len <= HANGMAN_MAX_LEN; len++) firstGuess[len] = hangman_best_letter(byLength[len], 0, scratch);
+    }
+
+    const HangmanColumns& words(int length) const { return byLength[length]; }
+    int first_guess(int length) const { return firstGuess[length]; }
+
+private:
+    HangmanColumns byLength[HANGMAN_MAX_LEN + 1];
+    int firstGuess[HANGMAN_MAX_LEN + 1];
+};
+
+// Decision-tree nodes with at least this many candidates are kept by the solver.
+constexpr std::uint32_t HANGMAN_MEMO_MIN = 64;
+
+// CPU guesser. Starts from the shared block for the word's length and, after each
+// answer, filters the surviving candidates into its own (shrinking) copy.
+//
+// The solver is deterministic, so where it stands in its decision tree is just the
+// word length plus the answers so far. Near the root - large candidate sets that many
+// words pass through - each node keeps its filtered candidates and chosen letter, so
+// later games walk those nodes instead of filtering and scoring from scratch. The
+// memo costs at most one byte per word and letter per tree level.
+class HangmanSolver {
+public:
+    void reset(const HangmanSolverIndex& index, int length) {
+        if (&index != memoIndex) {
+            memo.clear();
+            memoIndex = &index;
+        }
+        source = &index.words(length);
+        current = source;
+        node = nullptr;
+        firstGuess = index.first_guess(length);
+        guessed = 0;
+        path = 0x9E3779B97F4A7C15ULL * static_cast<std::uint64_t>(length + 1);
+    }
+
+    std::uint32_t candidates() const { return current->count; }
+
+    int next_guess() {
+        if (guessed == 0) return firstGuess;
+        if (node && node->letter >= 0) return node->letter;
+        int letter = hangman_best_letter(*current, guessed, scratch);
+        if (node) node->letter = letter;
+        return letter;
+    }
+
+    // The answer to a guess: the positions `letter` occupies (0 for a miss).
+    void observe(int letter, std::uint32_t positions) {
+        guessed |= 1u << letter;
+        path = (path ^ (std::uint64_t(letter) << 32 | positions)) * 0xBF58476D1CE4E5B9ULL;
+        path ^= path >> 31;
+
+        auto known = memo.find(path);
+        if (known != memo.end() && known->second.guessed == guessed) {
+            node = &known->second;
+            current = &node->words;
+            return;
+        }
+
+        const HangmanColumns& from = *current;
+        std::uint32_t blocks = (from.count + 31) / 32;
+        scratch.keep.resize(blocks + 1);
+        hangman_match(from, letter, positions, scratch.keep.data());
+        std::uint32_t kept = 0;
+        for (std::uint32_t b = 0; b < blocks; b++) kept += static_cast<std::uint32_t>(__builtin_popcount(scratch.keep[b]));
+
+        if (kept >= HANGMAN_MEMO_MIN && known == memo.end()) {
+            node = &memo[path];
+            node->guessed = guessed;
+            hangman_compact(from, scratch.keep.data(), kept, node->words);
+            current = &node->words;
+        } else {
+            node = nullptr;
+            hangman_compact(from, scratch.keep.data(), kept, own);
+            current = &own;
+        }
+    }
+
+private:
+    struct Node {
+        HangmanColumns words;
+        std::uint32_t guessed = 0;  // Guards against a path-hash collision
+        int letter = -1;            // Best next guess, once scored
+    };
+
+    const HangmanColumns* source = nullptr;
+    const HangmanColumns* current = nullptr;
+    Node* node = nullptr;           // Memo node for `current`, if it is one
+    const HangmanSolverIndex* memoIndex = nullptr;
+    HangmanColumns own;
+    HangmanScratch scratch;
+    std::unordered_map<std::uint64_t, Node> memo;   // Path hash -> node; node addresses are stable
+    std::uint64_t path = 0;
+    std::uint32_t guessed = 0;
+    int firstGuess = 0;
+};
+
+// --dict: the word list hangman_dictionary() loads on first use. Empty keeps the
+// built-in words. Set while parsing options, before any thread starts.
+inline std::string& hangman_dictionary_path() {
+    static std::string path;
+    return path;
+}
+
+// Why the --dict list could not be used, once hangman_dictionary() has tried; else empty.
+inline std::string& hangman_dictionary_error() {
+    static std::string error;
+    return error;
+}
+
+// The dictionary the Hangman module draws from. Mapping and indexing a big list is
+// done by whichever thread asks first; anyone else asking meanwhile waits for it.
+inline HangmanDictionary& hangman_dictionary() {
+    static HangmanDictionary dictionary;
+    static const bool loaded = [] {
+        std::string error;
+        const std::string& path = hangman_dictionary_path();
+        if (path.empty()) return true;
+        if (!dictionary.load(path, error)) hangman_dictionary_error() = error;
+        return true;
+    }();
+    (void)loaded;
+    return dictionary;
+}
+
+// Solver layout of hangman_dictionary(), built on first use.
+inline const HangmanSolverIndex& hangman_solver_index() {
+    static const HangmanSolverIndex index(hangman_dictionary());
+    return index;
+}
+
+#endif
@@ -15,22 +15,55 @@
  * GITHUB NOTES:
  * - Uses standard C++ libraries + <windows.h> for console coloring.
  * - Implements a robust input validation engine to prevent runtime crashes.
+ * - Game rules live in headless engine headers (ttt.h, dice.h, ...) so the
+ *   multi-threaded simulation mode (sim.h) can reuse them without any UI.
+ * - The UI is written as C++20 coroutines (task.h), so server mode can keep
+ *   thousands of games waiting for input on a single thread.
+ * - bench.cpp times the engine kernels and UI paths on their own.
  * ======================================================================================
  */
 
 #include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
 #include <string>
-#include <ctime>
+#include <string_view>
+#include <charconv>
 #include <thread>
 #include <chrono>
 #include <vector>
 #include <cctype>
+#include <cstdio>
 #include <cstdlib>
 #include <climits>
 #include <algorithm> 
+#include <functional>
+#include <memory_resource>
+
+#include "arena.h"
+#include "dice.h"
+#include "events.h"
+#include "hangman.h"
+#include "metrics.h"
+#include "mnk.h"
+#include "players.h"
+#include "pool.h"
+#include "record.h"
+#include "rng.h"
+#include "rps.h"
+#include "secret.h"
+#include "server.h"
+#include "sim.h"
+#include "task.h"
+#include "term.h"
+#include "ttt.h"
 
 // Platform specific check for Windows console colors
 #ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX   // Keep std::min/std::max usable in the engine headers
+#endif
 #include <windows.h>
 #endif
 
@@ -45,188 +78,743 @@ const int COLOR_YELLOW  = 14;     // Yellow
 const int COLOR_PURPLE  = 13;     // Magenta
 const int COLOR_CYAN    = 3;      // Dark Cyan
 
+// Boards offered by the Tic-Tac-Toe menu, and the CPU's per-move search budgets
+const MnkRules TTT_PRESETS[] = { {3, 3, 3}, {4, 4, 4}, {5, 5, 4}, {7, 7, 5}, {15, 15, 5} };
+const int TTT_PRESET_COUNT = sizeof(TTT_PRESETS) / sizeof(TTT_PRESETS[0]);
+const int AI_BUDGETS_MS[] = { 100, 300, 600, 1500, 3000 };
+const int AI_BUDGET_COUNT = sizeof(AI_BUDGETS_MS) / sizeof(AI_BUDGETS_MS[0]);
+const int SERVER_THINK_MS = 50;     // Per-move cap for network games; pool workers are shared
+const int SERVER_MC_MILLIONS = 20;  // Network Monte Carlo runs on the session's own worker: ~30 ms
+const int SERVER_DICE_MAX = 100;    // Network exact odds: up to 100 dice of 100 sides, a few ms
+
 // --- GLOBAL STATE ---
-// Note: In larger enterprise apps, we would wrap these in a Class or Struct.
-char board[9] = { ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ' };
+// One player's settings and buffers. The console has one; in server mode every
+// connection gets its own, bound while its session runs.
+struct HubSession {
+    int tttPreset = 0;          // Index into TTT_PRESETS
+    int aiBudget = 2;           // Index into AI_BUDGETS_MS; 600 ms matches the old think pause
+    uint64_t secretMin = 1;     // Secret Number range; anything inside 64 bits
+    uint64_t secretMax = 100;
+    bool turboMode = false;     // Drop every cosmetic pause and animation
+    string inputLine;           // Line buffer shared by every prompt; keeps its capacity between reads
+    int player = -1;            // Index in the player store (--players); -1 plays as a guest
+#ifdef GAMEHUB_SERVER
+    ServerConnection* remote = nullptr;     // Set for network players
+#endif
+};
+
+const chrono::steady_clock::time_point processStart = chrono::steady_clock::now();   // As close to exec as we get
+
+HubSession consoleSession;
+SessionArena consoleArena;
+thread_local HubSession* boundSession = nullptr;   // The network session this thread is running, if any
+bool replayMode = false;    // --replay: scripted input, no pacing, output hashed instead of shown
+string consolePlayer;       // --player: who the console plays as when stats are kept
+
+HubSession& session() {
+    return boundSession ? *boundSession : consoleSession;
+}
+
+// Where the running session's per-game state goes (boards, words); see arena.h
+SessionArena& session_arena() {
+    return arena_binding() ? *arena_binding() : consoleArena;
+}
+
+bool isRemote() {
+#ifdef GAMEHUB_SERVER
+    return session().remote != nullptr;
+#else
+    return false;
+#endif
+}
+
+// --record: a played game goes to disk as soon as it ends (record.h)
+RecordSource record_source() {
+    return isRemote() ? RECORD_SERVER : RECORD_CONSOLE;
+}
+
+void record_played(const GameRecord& record) {
+    record_game(record);
+    record_commit();
+}
+
+// --players: counts a result for the signed-in player; guests aren't tracked (players.h)
+void record_stat(PlayerEvent event, uint32_t a, uint32_t b = 0) {
+    if (session().player >= 0) player_store().record(session().player, event, a, b);
+}
+
+// Warms up lazily loaded modules (a --dict and its solver index) off the main
+// thread, so the first Hangman game normally finds them ready. Joined on the way out.
+struct ModulePrefetch {
+    thread worker;
+    void start() {
+        if (!worker.joinable() && !hangman_dictionary_path().empty()) worker = thread([] { hangman_solver_index(); });
+    }
+    ~ModulePrefetch() { if (worker.joinable()) worker.join(); }
+};
+ModulePrefetch* bootPrefetch = nullptr;     // The console starts it once the first menu is up
+
+// Thrown when input runs out; unwinds the current session back to whoever started it.
+struct SessionEnded {};
 
 // --- FUNCTION PROTOTYPES ---
 
+// Session
+Task<void> run_hub();
+Task<void> sign_in();
+Task<void> leaderboard();
+int run_replay(const string& path);
+int run_server(int port, int statsPort);
+
 // UI & System
 void setColor(int color);
-void drawHeader(string title);
+void drawHeader(string_view title);
 void drawDivider();
-void loadingScreen(string message);
 void clearScreen();
-void pauseGame();
+Task<void> pauseGame();
+Task<void> readLine(string& line, bool singleKey = false);
+Task<void> editLine(string& line, bool singleKey);
+Task<bool> nextKey(char& key);
+bool keyAtATime();
+Task<bool> waitForKey(int ms);
+Task<void> pace(int ms);
+double elapsedSeconds(chrono::steady_clock::time_point start);
+Task<void> animate(int frames, int intervalMs, const function<void(int)>& drawFrame);
 
 // Input Validation Engine
-int getValidatedInt(string prompt, int min, int max);
+template <class T> Task<T> getValidated(string_view prompt, T min, T max);
+Task<int> getValidatedInt(string_view prompt, int min, int max);
 
 // Game Modules
-void dice_roll();
-void secret_numbers();
-void tic_tac_toe_menu();
-void rock_paper_scissors();
-void hangman_game();
+Task<void> dice_roll();
+Task<void> dice_monte_carlo();
+Task<void> dice_probability();
+Task<void> secret_numbers();
+Task<void> secret_player_round();
+Task<void> secret_cpu_round();
+Task<void> tic_tac_toe_menu();
+Task<void> rock_paper_scissors();
+Task<void> hangman_game();
 
 // Logic Helpers
-void tic_tac_toe_pvp();
-void tic_tac_toe_pvc();
-void show_board();
-char check_winner();
-void clearboard();
-void computer_turn(); 
-bool place_marker(int slot, char marker);
+Task<void> tic_tac_toe_pvp(MnkBoard& board);
+Task<void> tic_tac_toe_pvc(MnkBoard& board);
+void show_board(const MnkBoard& board);
+char stone_char(const MnkBoard& board, int cell);
+Task<int> read_board_move(const MnkBoard& board, string_view command);
 void drawHangman(int lives);
 
 /**
  * ======================================================================================
  * MAIN ENTRY POINT
+ * bench.cpp includes this file with GAMEHUB_NO_MAIN defined, to drive the UI and the
+ * engines without it.
  * ======================================================================================
  */
-int main() {
+#ifndef GAMEHUB_NO_MAIN
+int main(int argc, char* argv[]) {
+    SimConfig sim;
+    bool simulate = false;
+    string replayPath;
+    string recordsPath;
+    bool seedGiven = false;
+    bool lineInput = false;
+    int servePort = 0;
+    int statsPort = 0;
+    bool statsDump = false;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--simulate") {
+            simulate = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-') sim.game = argv[++i];
+        } else if (arg == "--games" && i + 1 < argc) {
+            sim.games = atoll(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            sim.threads = atoi(argv[++i]);
+        } else if (arg == "--full-redraw") {
+            terminal_diff_enabled() = false;
+        } else if (arg == "--no-simd") {
+            dice_simd_enabled() = false;
+            hangman_simd_enabled() = false;
+        } else if (arg == "--serve" && i + 1 < argc) {
+            servePort = atoi(argv[++i]);
+        } else if (arg == "--replay" && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (arg == "--dict" && i + 1 < argc) {
+            hangman_dictionary_path() = argv[++i];     // Loaded on first use
+        } else if (arg == "--record" && i + 1 < argc) {
+            string error;
+            if (!record_log().open(argv[++i], error)) {
+                cerr << "Cannot record games to " << argv[i] << " (" << error << ")\n";
+                return 1;
+            }
+        } else if (arg == "--read-records" && i + 1 < argc) {
+            recordsPath = argv[++i];
+        } else if (arg == "--players" && i + 1 < argc) {
+            string error;
+            if (!player_store().open(argv[++i], error)) {
+                cerr << "Cannot keep player stats (" << error << ")\n";
+                return 1;
+            }
+        } else if (arg == "--player" && i + 1 < argc) {
+            consolePlayer = argv[++i];
+            if (!player_name_valid(consolePlayer)) {
+                cerr << "Player names are 1-" << PLAYER_NAME_MAX << " letters, digits, '-' or '_'\n";
+                return 1;
+            }
+        } else if (arg == "--stats") {
+            metrics_start();
+            statsDump = true;
+        } else if (arg == "--stats-port" && i + 1 < argc) {
+            statsPort = atoi(argv[++i]);
+            metrics_start();
+        } else if (arg == "--line-input") {
+            lineInput = true;
+        } else if (arg == "--turbo") {
+            consoleSession.turboMode = true;
+        } else if (arg == "--seed" && i + 1 < argc) {
+            rng_set_seed(strtoull(argv[++i], nullptr, 10));
+            seedGiven = true;
+        } else {
+            cerr << "Unknown option: " << arg << "\n"
+                 << "Usage: " << argv[0] << " [--simulate [ttt|rps|dice|secret|hangman|all]] [--games N] [--threads T] [--seed S] [--no-simd] [--full-redraw] [--turbo] [--line-input] [--dict FILE] [--record FILE] [--read-records FILE] [--players FILE] [--player NAME] [--stats] [--stats-port PORT] [--replay FILE|-] [--serve PORT]\n";
+            return 1;
+        }
+    }
+
+    work_pool_threads() = sim.threads;     // Sizes the pool behind simulations, Monte Carlo and server sessions
+
+    // --stats: the report goes to stderr however the run ends, so stdout (replay
+    // checksums, simulation tables) reads the same with or without it
+    struct StatsDump {
+        bool on;
+        ~StatsDump() { if (on) metrics_report(cerr); }
+    } statsAtExit{statsDump};
+
+    // Headless runs take the word list up front and say at once if it is unusable
+    if (simulate || !replayPath.empty()) {
+        hangman_dictionary();
+        if (!hangman_dictionary_error().empty()) cerr << "Dictionary not loaded (" << hangman_dictionary_error() << "); using the built-in words\n";
+    }
+
+    ModulePrefetch prefetch;
+    // Headless mode: no UI, no delays, straight to the report
+    if (!recordsPath.empty()) return print_record_summary(recordsPath, cout);
+    if (simulate) return run_simulation(sim);
+    if (!replayPath.empty()) {
+        if (!seedGiven) rng_set_seed(0);    // Checksums must not depend on the clock
+        return run_replay(replayPath);
+    }
+    if (servePort > 0) {
+        prefetch.start();
+        return run_server(servePort, statsPort);
+    }
+
+    terminal_init();
+    if (!lineInput) raw_input_begin();
+
     #ifdef _WIN32
-    system("title Ultimate Console Game Hub - Dev: Muhammad Taha");
+    SetConsoleTitleA("Ultimate Console Game Hub - Dev: Muhammad Taha");
     #endif
-    
-    // Seed the random number generator once at startup
-    srand(static_cast<unsigned int>(time(0))); 
 
-    loadingScreen("INITIALIZING KERNEL");
+    arena_binding() = &consoleArena;
+    bootPrefetch = &prefetch;
+    try {
+        run_blocking(run_hub());
+    } catch (const SessionEnded&) {
+        // Input closed (Ctrl+D / Ctrl+Z): leave the last screen up and quit quietly
+        out() << "\n";
+        terminal().present();
+    }
+    return 0;
+}
+#endif
+
+// One player session: the main menu until Exit. Nothing is loaded before it shows;
+// modules set themselves up on first use.
+Task<void> run_hub() {
+    co_await sign_in();
+    bool ranked = player_store().is_open();
+    bool booting = !isRemote() && !replayMode;  // Console start-up is timed to the first menu (--stats)
 
     while (true) {
+        ArenaScope game(session_arena());   // Whatever the module allocates goes when it returns
         clearScreen();
         drawHeader("MAIN MENU");
         
-        setColor(COLOR_BLUE); cout << "\t[1] "; setColor(COLOR_DEFAULT); cout << "Dice Roll Challenge\n";
-        setColor(COLOR_BLUE); cout << "\t[2] "; setColor(COLOR_DEFAULT); cout << "Secret Number Guessing\n";
-        setColor(COLOR_BLUE); cout << "\t[3] "; setColor(COLOR_DEFAULT); cout << "Tic-Tac-Toe (PvP & PvCPU)\n";
-        setColor(COLOR_BLUE); cout << "\t[4] "; setColor(COLOR_DEFAULT); cout << "Rock, Paper, Scissors\n";
-        setColor(COLOR_BLUE); cout << "\t[5] "; setColor(COLOR_DEFAULT); cout << "Hangman (Word Survival)\n";
+        setColor(COLOR_BLUE); out() << "\t[1] "; setColor(COLOR_DEFAULT); out() << "Dice Roll Challenge\n";
+        setColor(COLOR_BLUE); out() << "\t[2] "; setColor(COLOR_DEFAULT); out() << "Secret Number Guessing\n";
+        setColor(COLOR_BLUE); out() << "\t[3] "; setColor(COLOR_DEFAULT); out() << "Tic-Tac-Toe (PvP & PvCPU)\n";
+        setColor(COLOR_BLUE); out() << "\t[4] "; setColor(COLOR_DEFAULT); out() << "Rock, Paper, Scissors\n";
+        setColor(COLOR_BLUE); out() << "\t[5] "; setColor(COLOR_DEFAULT); out() << "Hangman (Word Survival)\n";
+        setColor(COLOR_BLUE); out() << "\t[6] "; setColor(COLOR_DEFAULT); out() << "Turbo Mode: " << (session().turboMode ? "ON" : "OFF") << "\n";
+        if (ranked) { setColor(COLOR_BLUE); out() << "\t[7] "; setColor(COLOR_DEFAULT); out() << "Leaderboard\n"; }
         
         drawDivider();
-        setColor(COLOR_RED);  cout << "\t[0] "; setColor(COLOR_DEFAULT); cout << "Exit Application\n";
+        setColor(COLOR_RED);  out() << "\t[0] "; setColor(COLOR_DEFAULT); out() << "Exit Application\n";
         
-        int choice = getValidatedInt("\n\tSelect Module > ", 0, 5);
+        if (booting) {
+            terminal().present();
+            metric_record_since(METRIC_STARTUP, processStart);
+            if (bootPrefetch) bootPrefetch->start();
+            booting = false;
+        }
+        int choice = co_await getValidatedInt("\n\tSelect Module > ", 0, ranked ? 7 : 6);
 
         switch (choice) {
-            case 1: dice_roll(); break;
-            case 2: secret_numbers(); break;
-            case 3: tic_tac_toe_menu(); break;
-            case 4: rock_paper_scissors(); break;
-            case 5: hangman_game(); break;
+            case 1: co_await dice_roll(); break;
+            case 2: co_await secret_numbers(); break;
+            case 3: co_await tic_tac_toe_menu(); break;
+            case 4: co_await rock_paper_scissors(); break;
+            case 5: co_await hangman_game(); break;
+            case 6: session().turboMode = !session().turboMode; break;
+            case 7: co_await leaderboard(); break;
             case 0:
                 setColor(COLOR_GREEN);
-                cout << "\n\tTerminating session. Goodbye!\n";
+                out() << "\n\tTerminating session. Goodbye!\n";
                 setColor(COLOR_DEFAULT);
-                this_thread::sleep_for(chrono::seconds(1));
-                return 0;
+                co_await pace(1000);
+                co_return;
+        }
+    }
+}
+
+// --players: the console plays as --player (or the login name); network players are
+// asked, and a blank answer plays as a guest.
+Task<void> sign_in() {
+    HubSession& hub = session();
+    if (!player_store().is_open() || hub.player >= 0) co_return;
+    if (!isRemote()) {
+        string name = consolePlayer;
+        if (name.empty()) {
+            const char* login = getenv("USER");
+            if (!login) login = getenv("USERNAME");
+            name = login && player_name_valid(login) ? login : "player";
+        }
+        hub.player = player_store().join(name);
+        co_return;
+    }
+
+    clearScreen();
+    drawHeader("SIGN IN");
+    while (true) {
+        out() << "\tPlayer name (blank for guest) > ";
+        co_await readLine(hub.inputLine);
+        if (hub.inputLine.empty()) co_return;
+        if (player_name_valid(hub.inputLine)) {
+            hub.player = player_store().join(hub.inputLine);
+            co_return;
+        }
+        setColor(COLOR_RED); out() << "\t[!] Up to " << PLAYER_NAME_MAX << " letters, digits, '-' or '_'.\n"; setColor(COLOR_DEFAULT);
+    }
+}
+
+Task<void> leaderboard() {
+    clearScreen();
+    drawHeader("LEADERBOARD");
+    PlayerLeaderboard board = player_store().leaderboard();
+    if (board.count == 0) out() << "\tNo results yet.\n";
+    for (int i = 0; i < board.count; i++) {
+        const PlayerStats& p = board.rows[i];
+        setColor(i == 0 ? COLOR_YELLOW : COLOR_DEFAULT);
+        out() << "\t" << setw(2) << i + 1 << ". " << left << setw(PLAYER_NAME_MAX + 2) << p.name << right << setw(6) << p.score << " pts\n";
+    }
+    setColor(COLOR_DEFAULT);
+
+    if (session().player >= 0) {
+        PlayerStats me = player_store().stats(session().player);
+        drawDivider();
+        out() << "\n\t" << me.name << ": " << me.score << " pts\n";
+        out() << "\t  Tic-Tac-Toe vs CPU  " << me.tttWins << " won, " << me.tttDraws << " drawn of " << me.tttGames << "\n";
+        out() << "\t  Secret Number       " << me.secretRounds << " solved";
+        if (me.secretRounds) {
+            // Formatted apart, so the session's stream keeps its own precision
+            char average[32];
+            snprintf(average, sizeof(average), "%.1f", double(me.secretAttempts) / me.secretRounds);
+            out() << ", best " << me.secretBest << " tries, avg " << average;
+        }
+        out() << "\n";
+        out() << "\t  Hangman             " << me.hangmanSurvived << " survived of " << me.hangmanGames << "\n";
+        out() << "\t  Rock Paper Scissors " << me.rpsWins << " won of " << me.rpsRounds << " rounds\n";
+    }
+    co_await pauseGame();
+}
+
+/**
+ * ======================================================================================
+ * REPLAY DRIVER
+ * Runs recorded input through the hub back to back: each session lasts until its Exit
+ * (or the end of the stream), with pacing and clears skipped and the output reduced to
+ * a checksum. Each session reseeds the RNG from --seed and its index, so a given
+ * recording produces the same checksums on every run and can be diffed between builds.
+ * ======================================================================================
+ */
+int run_replay(const string& path) {
+    ios::sync_with_stdio(false);    // Lines come from cin; the per-character stdio lock dominates otherwise
+    ifstream file;
+    streambuf* console = cin.rdbuf();
+    if (path != "-") {
+        file.open(path, ios::binary);
+        if (!file) {
+            cerr << "Cannot open replay file: " << path << "\n";
+            return 1;
+        }
+        cin.rdbuf(file.rdbuf());
+    }
+
+    replayMode = true;
+    arena_binding() = &consoleArena;
+    OutputDigest digest;
+    long long sessions = 0;
+    unsigned long long totalBytes = 0;
+    auto start = chrono::steady_clock::now();
+
+    while (cin.peek() != char_traits<char>::eof()) {
+        sessions++;
+        digest = OutputDigest();
+        terminal().capture(&digest);
+        threadRng() = Rng(rng_seed(), static_cast<uint64_t>(sessions));
+        consoleSession = HubSession();  // Every session starts from the default settings
+        consoleArena.reset();
+
+        const char* ending = "exit";
+        try {
+            run_blocking(run_hub());
+        } catch (const SessionEnded&) {
+            ending = "eof";
         }
+        terminal().present();
+        totalBytes += digest.bytes;
+
+        cout << "session " << sessions << "  bytes " << digest.bytes
+             << "  fnv1a " << hex << setw(16) << setfill('0') << digest.hash << dec << setfill(' ')
+             << "  " << ending << "\n";
     }
+
+    terminal().capture(nullptr);
+    cin.rdbuf(console);
+    cout.flush();
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cerr << "Replayed " << sessions << " sessions (" << totalBytes << " bytes of output) in "
+         << fixed << setprecision(3) << seconds << " s";
+    if (seconds > 0) cerr << ", " << setprecision(0) << sessions / seconds << " sessions/s";
+    cerr << "\n";
     return 0;
 }
 
+/**
+ * ======================================================================================
+ * SERVER DRIVER
+ * --serve PORT: one hub session per TCP connection. The loop in server.h does the I/O;
+ * each session is a coroutine run in stretches on the work pool. Its state (settings,
+ * terminal, RNG, line buffer) lives in its frame and is bound to the running thread's
+ * globals only while it runs.
+ * ======================================================================================
+ */
+#ifdef GAMEHUB_SERVER
+struct RemotePlayer {
+    HubSession hub;
+    Terminal screen;
+    Rng rng;
+    SessionArena arena;     // Frames below serve_player, and per-game state
+
+    explicit RemotePlayer(ServerConnection& conn)
+        : screen(&conn.outbox()), rng(rng_seed(), conn.id()) {
+        hub.remote = &conn;
+        hub.turboMode = consoleSession.turboMode;
+    }
+};
+
+void bind_remote(ServerConnection& conn) {
+    RemotePlayer* player = static_cast<RemotePlayer*>(conn.user);
+    boundSession = player ? &player->hub : nullptr;
+    terminal_binding() = player ? &player->screen : nullptr;
+    rng_binding() = player ? &player->rng : nullptr;
+    arena_binding() = player ? &player->arena : nullptr;
+}
+
+void unbind_remote(ServerConnection&) {
+    boundSession = nullptr;
+    terminal_binding() = nullptr;
+    rng_binding() = nullptr;
+    arena_binding() = nullptr;
+}
+
+Task<void> serve_player(ServerConnection& conn) {
+    RemotePlayer player(conn);
+    conn.user = &player;
+    bind_remote(conn);
+    try {
+        co_await run_hub();
+    } catch (const SessionEnded&) {
+        // Disconnected mid-game; nothing left to show
+    }
+    terminal().present();
+    conn.user = nullptr;
+}
+
+// The stats port's report: the server's own line, then the metrics (metrics.h)
+void server_report(string& text) {
+    ostringstream report;
+    metrics_report(report);
+    text += report.str();
+}
+
+int run_server(int port, int statsPort) {
+    ServerHooks hooks;
+    hooks.session = serve_player;
+    hooks.enter = bind_remote;
+    hooks.leave = unbind_remote;
+    hooks.report = server_report;
+    GameServer server(hooks);
+    return server.run(port, statsPort);
+}
+#else
+int run_server(int, int) {
+    cerr << "Server mode needs a POSIX system (epoll or kqueue).\n";
+    return 1;
+}
+#endif
+
 /**
  * ======================================================================================
  * INPUT VALIDATION ENGINE
  * Ensures the program never crashes due to invalid data types (char vs int).
  * ======================================================================================
  */
-int getValidatedInt(string prompt, int min, int max) {
+// One parser for every integer prompt. Instantiated per type, so the int prompts
+// keep their 32-bit conversion and range test; 64-bit ranges get their own copy.
+template <class T>
+Task<T> getValidated(string_view prompt, T min, T max) {
+    bool singleKey = max <= 9;
+    if constexpr (is_signed_v<T>) singleKey = singleKey && min >= 0;
     while (true) {
-        cout << prompt;
-        string input;
-        getline(cin, input);
+        out() << prompt;
+        // Answers that are always one digit commit on the keystroke itself
+        string& line = session().inputLine;
+        {
+            MetricTimer wait(METRIC_INPUT_WAIT);
+            co_await readLine(line, singleKey);
+        }
+        MetricTimer parse(METRIC_INPUT_PARSE);      // Through the error message, if any
+        const char* first = line.data();
+        const char* last = first + line.size();
 
         // 1. Empty Check
-        if (input.empty()) {
-            setColor(COLOR_RED); cout << "\t[!] Input required.\n"; setColor(COLOR_DEFAULT);
+        if (first == last) {
+            setColor(COLOR_RED); out() << "\t[!] Input required.\n"; setColor(COLOR_DEFAULT);
             continue;
         }
 
-        // 2. Numeric Check
-        bool isNumber = true;
-        if (input[0] == '-') isNumber = false; 
-        for (char c : input) {
-            if (!isdigit(c)) {
-                isNumber = false;
-                break;
-            }
-        }
-
-        if (!isNumber) {
-            setColor(COLOR_RED); cout << "\t[!] Invalid format. Numbers only.\n"; setColor(COLOR_DEFAULT);
+        // 2. Numeric Check: one pass; digits only, so a sign or stray character
+        // anywhere (even after an overflowing run of digits) is a format error
+        T value = 0;
+        from_chars_result parsed = from_chars(first, last, value);
+        if (*first == '-' || parsed.ptr != last) {
+            setColor(COLOR_RED); out() << "\t[!] Invalid format. Numbers only.\n"; setColor(COLOR_DEFAULT);
             continue;
         }
 
         // 3. Range Check
-        try {
-            int value = stoi(input);
-            if (value >= min && value <= max) {
-                return value;
-            } else {
-                setColor(COLOR_RED); 
-                cout << "\t[!] Range Error: Enter " << min << "-" << max << ".\n"; 
-                setColor(COLOR_DEFAULT);
-            }
-        } catch (...) {
-            setColor(COLOR_RED); cout << "\t[!] Overflow Error.\n"; setColor(COLOR_DEFAULT);
+        if (parsed.ec == errc::result_out_of_range) {
+            setColor(COLOR_RED); out() << "\t[!] Overflow Error.\n"; setColor(COLOR_DEFAULT);
+        } else if (value >= min && value <= max) {
+            co_return value;
+        } else {
+            setColor(COLOR_RED); 
+            out() << "\t[!] Range Error: Enter " << min << "-" << max << ".\n"; 
+            setColor(COLOR_DEFAULT);
         }
     }
 }
 
+Task<int> getValidatedInt(string_view prompt, int min, int max) {
+    return getValidated<int>(prompt, min, max);
+}
+
 // --- UI & GRAPHICS FUNCTIONS ---
 
+// Colors travel inside the frame as escape codes, in order with the text
 void setColor(int color) {
-    #ifdef _WIN32
-        SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), color);
-    #endif
+    terminal().set_color(color);
 }
 
+// Escape-sequence clear; no child process per redraw
 void clearScreen() {
-    #ifdef _WIN32
-        system("cls");
-    #else
-        system("clear");
-    #endif
+    MetricTimer timer(METRIC_RENDER_CLEAR);
+    terminal().begin_frame();
 }
 
 /**
  * Draws the persistent Developer Branding and the specific screen title.
  * This ensures "Muhammad Taha" is visible on every screen.
  */
-void drawHeader(string title) {
+void drawHeader(string_view title) {
+    MetricTimer timer(METRIC_RENDER_HEADER);
     // --- STYLISH LEFT-ALIGNED BRANDING ---
     setColor(COLOR_CYAN);
-    cout << "\n  // DEV: MUHAMMAD TAHA // \n";
+    out() << "\n  // DEV: MUHAMMAD TAHA // \n";
     setColor(COLOR_DEFAULT);
 
     // --- CENTERED TITLE ---
     setColor(COLOR_PURPLE);
-    cout << "\t=========================================\n";
-    cout << "\t   " << title << "\n";
-    cout << "\t=========================================\n\n";
+    out() << "\t=========================================\n";
+    out() << "\t   " << title << "\n";
+    out() << "\t=========================================\n\n";
     setColor(COLOR_DEFAULT);
 }
 
 void drawDivider() {
     setColor(COLOR_PURPLE);
-    cout << "\n\t-----------------------------------------";
+    out() << "\n\t-----------------------------------------";
     setColor(COLOR_DEFAULT);
 }
 
-void pauseGame() {
-    cout << "\n\tPress [ENTER] to return...";
-    cin.get();
+Task<void> pauseGame() {
+    out() << "\n\tPress [ENTER] to return...";
+    terminal().present();
+    if (isRemote() && !keyAtATime()) {
+        co_await editLine(session().inputLine, false);  // Line-mode client: wait out the whole line
+        co_return;
+    }
+    if (raw_input_active() || isRemote()) {
+        char key;
+        if (!co_await nextKey(key) || key == 0x04) throw SessionEnded();
+        out() << "\n";
+        co_return;
+    }
+    bool typedAhead = !replayMode && input_ready(0);
+    if (cin.get() == char_traits<char>::eof()) throw SessionEnded();
+    if (typedAhead) terminal().resync();
+    else terminal().echoed("");
 }
 
-void loadingScreen(string message) {
-    cout << "\n\n\t" << message;
-    for(int i=0; i<3; i++) {
-        cout << ".";
-        this_thread::sleep_for(chrono::milliseconds(200));
+// Waiting for the player ends the frame: present it, then block on the line
+Task<void> readLine(string& line, bool singleKey) {
+    terminal().present();
+    if (raw_input_active() || isRemote()) {
+        co_await editLine(line, singleKey);
+        co_return;
     }
-    clearScreen();
+    bool typedAhead = !replayMode && input_ready(0);
+    if (!getline(cin, line)) throw SessionEnded();
+
+    // Type-ahead was echoed wherever the cursor happened to be; repaint from scratch
+    if (typedAhead) terminal().resync();
+    else terminal().echoed(line);
+}
+
+// Raw-mode line editor. The echo goes through the frame like any other text, so the
+// screen model always knows where the cursor is. Single-key prompts take the first
+// printable key (or a bare Enter) as the whole line; validation is unchanged.
+// A remote client that sends whole lines echoes them itself; its line is collected
+// unechoed and never cut short, so the Enter after an answer isn't read as the next one.
+Task<void> editLine(string& line, bool singleKey) {
+    line.clear();
+    while (true) {
+        char key;
+        if (!co_await nextKey(key)) throw SessionEnded();
+        // Asked per key: a telnet client's answer to our offers arrives just ahead of its first key
+        if (!keyAtATime()) {
+            if (key == '\r' || key == '\n') {
+                terminal().echoed(line);
+                co_return;
+            }
+            if (key == 0x04 && line.empty()) throw SessionEnded();
+            if (static_cast<unsigned char>(key) >= 0x20 && key != 0x7f) line.push_back(key);
+            continue;
+        }
+        if (key == '\r' || key == '\n') break;
+        if (key == 0x04) {                          // Ctrl+D on an empty line ends the session
+            if (line.empty()) throw SessionEnded();
+            continue;
+        }
+        if (key == '\b' || key == 0x7f) {
+            if (!line.empty()) {
+                line.pop_back();
+                out() << "\b \b";
+                terminal().present();
+            }
+            continue;
+        }
+        if (static_cast<unsigned char>(key) < 0x20) continue;
+
+        line.push_back(key);
+        out() << key;
+        if (singleKey) break;
+        terminal().present();
+    }
+    out() << "\n";
+}
+
+// Next keystroke from whoever is playing: the console keyboard, or (in server mode)
+// the session's socket, where waiting suspends the session instead of the process.
+Task<bool> nextKey(char& key) {
+#ifdef GAMEHUB_SERVER
+    if (ServerConnection* remote = session().remote) {
+        int next = co_await remote->next_key();
+        if (next < 0) co_return false;
+        key = static_cast<char>(next);
+        co_return true;
+    }
+#endif
+    co_return read_key(key);
+}
+
+// Keys arrive one at a time and the echo is ours: the raw-mode console, or a telnet
+// client that accepted our offers. Any other remote client sends whole lines.
+bool keyAtATime() {
+#ifdef GAMEHUB_SERVER
+    if (ServerConnection* remote = session().remote) return remote->key_mode();
+#endif
+    return raw_input_active();
+}
+
+// Waits up to `ms` on the event loop; true if a keypress cut it short.
+Task<bool> waitForKey(int ms) {
+#ifdef GAMEHUB_SERVER
+    if (ServerConnection* remote = session().remote) co_return co_await remote->wait_input(ms);
+#endif
+    event_loop().after(ms, [] {});
+    co_return event_loop().run();
+}
+
+// Pacing delay; the frame so far is shown first. Runs on the event loop rather than
+// sleeping, so a keypress ends it early and stays buffered for the next prompt.
+Task<void> pace(int ms) {
+    if (session().turboMode || replayMode || ms <= 0) co_return;
+    terminal().present();
+    co_await waitForKey(ms);
+}
+
+// Wall-clock time for the on-screen timing readouts. Replays show zero so a session's
+// checksum depends only on what it did, not on how fast the machine was.
+double elapsedSeconds(chrono::steady_clock::time_point start) {
+    if (replayMode) return 0;
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// Timer-driven animation: frame i is drawn and presented at i * intervalMs, and the last
+// one is held for a further interval. A keypress skips the rest; turbo skips it all.
+Task<void> animate(int frames, int intervalMs, const function<void(int)>& drawFrame) {
+    if (session().turboMode || replayMode) co_return;
+    if (isRemote()) {
+        // Sessions share the server loop; each frame waits as one timer on it
+        for (int i = 0; i < frames; i++) {
+            drawFrame(i);
+            terminal().present();
+            if (co_await waitForKey(intervalMs)) co_return;
+        }
+        co_return;
+    }
+    EventLoop& loop = event_loop();
+    for (int i = 0; i < frames; i++) {
+        loop.after(i * intervalMs, [&drawFrame, i] { drawFrame(i); terminal().present(); });
+    }
+    loop.after(frames * intervalMs, [] {});
+    loop.run();
 }
 
 /**
@@ -236,236 +824,507 @@ void loadingScreen(string message) {
  */
 
 // --- 1. DICE ROLL ---
-void dice_roll() {
+Task<void> dice_roll() {
     while (true) {
         clearScreen();
         drawHeader("DICE SIMULATOR");
-        cout << "\t[1] Roll Dice\n\t[0] Return\n";
+        out() << "\t[1] Roll Dice\n\t[2] Monte Carlo Fairness Test\n\t[3] Exact Probability Calculator\n\t[0] Return\n";
         
-        int choice = getValidatedInt("\n\tAction > ", 0, 1);
+        int choice = co_await getValidatedInt("\n\tAction > ", 0, 3);
         if (choice == 0) break;
-
-        setColor(COLOR_YELLOW); cout << "\n\tRolling physics..."; 
-        this_thread::sleep_for(chrono::milliseconds(500));
+        if (choice == 2) { co_await dice_monte_carlo(); continue; }
+        if (choice == 3) { co_await dice_probability(); continue; }
+
+        setColor(COLOR_YELLOW); out() << "\n\tRolling physics..."; 
+        // Tumbling faces are cosmetic, so they don't touch the RNG and a skipped
+        // animation leaves the roll sequence for a given --seed unchanged
+        co_await animate(10, 50, [](int f) {
+            out() << "\r\t[ DIE 1: " << (f * 5 + 2) % 6 + 1 << " ]   [ DIE 2: " << (f * 7 + 4) % 6 + 1 << " ]     ";
+        });
         
-        int d1 = rand() % 6 + 1;
-        int d2 = rand() % 6 + 1;
+        DiceRoll roll = roll_dice(threadRng());
+        metric_count(COUNT_DICE);
         
-        cout << "\r\t[ DIE 1: " << d1 << " ]   [ DIE 2: " << d2 << " ]     \n"; 
+        out() << "\r\t[ DIE 1: " << roll.d1 << " ]   [ DIE 2: " << roll.d2 << " ]     \n"; 
         
-        if (d1 == d2) {
-            setColor(COLOR_GREEN); cout << "\n\t>>> CRITICAL HIT! DOUBLES! <<<\n";
+        if (is_doubles(roll)) {
+            setColor(COLOR_GREEN); out() << "\n\t>>> CRITICAL HIT! DOUBLES! <<<\n";
         } else {
-            setColor(COLOR_RED); cout << "\n\tNo match.\n";
+            setColor(COLOR_RED); out() << "\n\tNo match.\n";
         }
         setColor(COLOR_DEFAULT);
-        pauseGame();
+        co_await pauseGame();
+    }
+}
+
+// Batch fairness check: billions of rolls on every core through the SIMD engine
+Task<void> dice_monte_carlo() {
+    // Network players share the pool with every other session, so they get one worker
+    // (their own) and a run that finishes inside a few think caps
+    bool remote = isRemote();
+    int maxMillions = remote ? SERVER_MC_MILLIONS : 10000;
+    char prompt[64];
+    snprintf(prompt, sizeof(prompt), "\n\tRolls in millions (1-%d) > ", maxMillions);
+    int millions = co_await getValidatedInt(prompt, 1, maxMillions);
+    int threads = remote ? 1 : work_pool().size();
+
+    setColor(COLOR_YELLOW); out() << "\n\tCrunching " << millions << "M rolls on " << threads << " thread(s)...\n"; setColor(COLOR_DEFAULT);
+    terminal().present();
+    auto start = chrono::steady_clock::now();
+    DiceBatchStats stats = run_dice_monte_carlo(millions * 1000000LL, threads, threadRng().next());
+    double seconds = elapsedSeconds(start);
+
+    print_dice_report(out(), stats, threads, seconds);
+    co_await pauseGame();
+}
+
+// Exact odds for N dice with K sides, straight from the cached convolution engine
+Task<void> dice_probability() {
+    // Big tables take a good part of a second to build; network players stay small
+    int maxDice = isRemote() ? SERVER_DICE_MAX : 1000;
+    char prompt[64];
+    snprintf(prompt, sizeof(prompt), "\n\tNumber of dice (1-%d) > ", maxDice);
+    int dice = co_await getValidatedInt(prompt, 1, maxDice);
+    snprintf(prompt, sizeof(prompt), "\tSides per die (2-%d) > ", maxDice);
+    int sides = co_await getValidatedInt(prompt, 2, maxDice);
+
+    auto start = chrono::steady_clock::now();
+    shared_ptr<const DiceDistribution> dist = dice_distribution(dice, sides);
+    double ms = elapsedSeconds(start) * 1000;
+
+    out() << "\n\tSums " << dist->min_sum() << "-" << dist->max_sum() << ", resolved in " << ms << " ms\n";
+    out() << "\tP(all dice equal) = " << dist->p_all_equal() << "\n";
+
+    // Short distributions are listed in full
+    if (dist->max_sum() - dist->min_sum() < 20) {
+        for (int sum = dist->min_sum(); sum <= dist->max_sum(); sum++) {
+            out() << "\t  P(sum = " << sum << ") = " << dist->p_sum(sum) << "\n";
+        }
     }
+
+    int target = co_await getValidatedInt("\n\tThreshold t > ", dist->min_sum(), dist->max_sum());
+    setColor(COLOR_GREEN);
+    out() << "\n\tP(sum >= " << target << ") = " << dist->p_at_least(target) << "\n";
+    out() << "\tP(sum == " << target << ") = " << dist->p_sum(target) << "\n";
+    setColor(COLOR_DEFAULT);
+    co_await pauseGame();
 }
 
 // --- 2. SECRET NUMBERS ---
-void secret_numbers() {
+Task<void> secret_numbers() {
+    HubSession& hub = session();
+    while(true) {
+        clearScreen();
+        drawHeader("BINARY SEARCH GAME");
+        out() << "\t[1] You Guess\n";
+        out() << "\t[2] CPU Guesses\n";
+        out() << "\t[3] Range: " << hub.secretMin << "-" << hub.secretMax << "\n";
+        out() << "\t[0] Return\n";
+
+        int choice = co_await getValidatedInt("\n\tSelect Mode > ", 0, 3);
+        if (choice == 0) break;
+        if (choice == 1) co_await secret_player_round();
+        else if (choice == 2) co_await secret_cpu_round();
+        else {
+            // Anything inside 0 to 2^64 - 1
+            uint64_t low = co_await getValidated<uint64_t>("\n\tLowest Number > ", 0, UINT64_MAX - 1);
+            hub.secretMax = co_await getValidated<uint64_t>("\tHighest Number > ", low + 1, UINT64_MAX);
+            hub.secretMin = low;
+        }
+    }
+}
+
+Task<void> secret_player_round() {
+    HubSession& hub = session();
     clearScreen();
     drawHeader("BINARY SEARCH GAME");
     
-    int secret = rand() % 100 + 1;
+    uint64_t secret = secret_pick(threadRng(), hub.secretMin, hub.secretMax);
     int attempts = 0;
     
-    cout << "\tTarget Locked: Number between 1-100.\n";
+    out() << "\tTarget Locked: Number between " << hub.secretMin << "-" << hub.secretMax << ".\n";
 
     while(true) {
-        int guess = getValidatedInt("\n\tInput Guess > ", 1, 100);
+        uint64_t guess = co_await getValidated<uint64_t>("\n\tInput Guess > ", hub.secretMin, hub.secretMax);
         attempts++;
 
-        if (guess == secret) {
+        SecretHint hint = secret_compare(guess, secret);
+        if (hint == SECRET_HIT) {
             setColor(COLOR_GREEN);
-            cout << "\n\t[SUCCESS] Target neutralized in " << attempts << " attempts!\n";
+            out() << "\n\t[SUCCESS] Target neutralized in " << attempts << " attempts!\n";
             setColor(COLOR_DEFAULT);
+            record_stat(PLAYER_SECRET, static_cast<uint32_t>(attempts));
+            metric_count(COUNT_SECRET);
             break;
-        } else if (guess < secret) {
-            setColor(COLOR_YELLOW); cout << "\t>>> Too Low. Adjust upwards.\n"; setColor(COLOR_DEFAULT);
+        } else if (hint == SECRET_LOW) {
+            setColor(COLOR_YELLOW); out() << "\t>>> Too Low. Adjust upwards.\n"; setColor(COLOR_DEFAULT);
         } else {
-            setColor(COLOR_YELLOW); cout << "\t>>> Too High. Adjust downwards.\n"; setColor(COLOR_DEFAULT);
+            setColor(COLOR_YELLOW); out() << "\t>>> Too High. Adjust downwards.\n"; setColor(COLOR_DEFAULT);
+        }
+    }
+    co_await pauseGame();
+}
+
+// The player picks the number and how trustworthy the hints are; the CPU solver
+// shows every question it asks.
+Task<void> secret_cpu_round() {
+    HubSession& hub = session();
+    clearScreen();
+    drawHeader("CPU CODEBREAKER");
+    out() << "\tNumber between " << hub.secretMin << "-" << hub.secretMax << ".\n";
+    uint64_t secret = co_await getValidated<uint64_t>("\n\tYour Secret > ", hub.secretMin, hub.secretMax);
+
+    out() << "\n\t[1] Honest Hints\n\t[2] Noisy Hints (10% flipped)\n\t[3] Up to 3 Lies\n";
+    int mode = co_await getValidatedInt("\n\tHint Mode > ", 1, 3);
+
+    SecretOracle oracle;
+    oracle.secret = secret;
+    SecretSolver solver;
+    if (mode == 2) {
+        oracle.flipChance = secret_chance(0.10);
+        solver.strategy = SECRET_VOTE;
+    } else if (mode == 3) {
+        oracle.flipChance = secret_chance(0.25);
+        oracle.liesLeft = 3;
+        solver.strategy = SECRET_LIAR_SAFE;
+        solver.lies = 3;
+    }
+
+    // Same solver as the benchmark, with every question echoed
+    struct Narrated {
+        SecretOracle& inner;
+        SecretHint ask(Rng& rng, uint64_t guess) {
+            SecretHint hint = inner.ask(rng, guess);
+            out() << "\t" << guess << (hint == SECRET_HIT ? "  HIT\n" : hint == SECRET_LOW ? "  too low\n" : "  too high\n");
+            return hint;
         }
+    } narrated{oracle};
+    out() << "\n";
+    SecretResult result = secret_solve(narrated, threadRng(), hub.secretMin, hub.secretMax, solver);
+    metric_count(COUNT_SECRET);
+
+    if (result.found) {
+        setColor(COLOR_GREEN);
+        out() << "\n\t[SUCCESS] CPU found it in " << result.attempts << " questions";
+        if (result.restarts) out() << " (" << result.restarts << " restart" << (result.restarts > 1 ? "s" : "") << ")";
+        out() << "!\n";
+    } else {
+        setColor(COLOR_RED);
+        out() << "\n\tCPU gave up after " << result.attempts << " questions.\n";
     }
-    pauseGame();
+    setColor(COLOR_DEFAULT);
+    co_await pauseGame();
 }
 
 // --- 3. TIC TAC TOE LOGIC ---
 
-void tic_tac_toe_menu() {
+Task<void> tic_tac_toe_menu() {
+    HubSession& hub = session();
     while(true) {
+        const MnkRules& rules = TTT_PRESETS[hub.tttPreset];
         clearScreen();
         drawHeader("STRATEGY ARENA (TTT)");
-        cout << "\t[1] PvHuman\n";
-        cout << "\t[2] PvAI (CPU)\n";
-        cout << "\t[0] Return\n";
+        out() << "\t[1] PvHuman\n";
+        out() << "\t[2] PvAI (CPU)\n";
+        out() << "\t[3] AI Time Budget: " << AI_BUDGETS_MS[hub.aiBudget] << " ms\n";
+        out() << "\t[4] Board: " << rules.width << "x" << rules.height << ", " << rules.k << " in a row\n";
+        out() << "\t[0] Return\n";
         
-        int choice = getValidatedInt("\n\tSelect Mode > ", 0, 2);
+        int choice = co_await getValidatedInt("\n\tSelect Mode > ", 0, 4);
 
         if(choice == 0) break;
+        if(choice == 3) { hub.aiBudget = (hub.aiBudget + 1) % AI_BUDGET_COUNT; continue; }
+        if(choice == 4) { hub.tttPreset = (hub.tttPreset + 1) % TTT_PRESET_COUNT; continue; }
         
-        clearboard();
-        if(choice == 1) tic_tac_toe_pvp();
-        else tic_tac_toe_pvc();
+        ArenaScope game(session_arena());
+        MnkBoard board(rules, &session_arena());
+        if(choice == 1) co_await tic_tac_toe_pvp(board);
+        else co_await tic_tac_toe_pvc(board);
     }
 }
 
-void show_board() {
+char stone_char(const MnkBoard& board, int cell) {
+    int stone = board.at(cell);
+    return stone == MNK_X ? 'X' : stone == MNK_O ? 'O' : ' ';
+}
+
+void show_board(const MnkBoard& board) {
+    MetricTimer timer(METRIC_RENDER_BOARD);
+    const MnkRules& rules = board.rules();
     setColor(COLOR_BLUE);
-    cout << "\n\t     |     |     " << endl;
-    cout << "\t  " << board[0] << "  |  " << board[1] << "  |  " << board[2] << "  " << endl;
-    cout << "\t_____|_____|_____" << endl;
-    cout << "\t     |     |     " << endl;
-    cout << "\t  " << board[3] << "  |  " << board[4] << "  |  " << board[5] << "  " << endl;
-    cout << "\t_____|_____|_____" << endl;
-    cout << "\t     |     |     " << endl;
-    cout << "\t  " << board[6] << "  |  " << board[7] << "  |  " << board[8] << "  " << endl;
-    cout << "\t     |     |     " << endl << endl;
+    if (rules.width == 3 && rules.height == 3) {
+        out() << "\n\t     |     |     \n";
+        out() << "\t  " << stone_char(board, 0) << "  |  " << stone_char(board, 1) << "  |  " << stone_char(board, 2) << "  \n";
+        out() << "\t_____|_____|_____\n";
+        out() << "\t     |     |     \n";
+        out() << "\t  " << stone_char(board, 3) << "  |  " << stone_char(board, 4) << "  |  " << stone_char(board, 5) << "  \n";
+        out() << "\t_____|_____|_____\n";
+        out() << "\t     |     |     \n";
+        out() << "\t  " << stone_char(board, 6) << "  |  " << stone_char(board, 7) << "  |  " << stone_char(board, 8) << "  \n";
+        out() << "\t     |     |     \n" << "\n";
+    } else {
+        // Compact grid with row/column numbers; empty cells as dots so lines stay readable
+        out() << "\n\t   ";
+        for (int col = 0; col < rules.width; col++) out() << setw(3) << col + 1;
+        out() << "\n";
+        for (int row = 0; row < rules.height; row++) {
+            out() << "\t" << setw(3) << row + 1;
+            for (int col = 0; col < rules.width; col++) {
+                char c = stone_char(board, board.index(row, col));
+                out() << "  " << (c == ' ' ? '.' : c);
+            }
+            out() << "\n";
+        }
+        out() << "\n";
+    }
     setColor(COLOR_DEFAULT);
 }
 
-bool place_marker(int slot, char marker) {
-    if(board[slot-1] == ' ') {
-        board[slot-1] = marker;
-        return true;
+// Boards of up to RECORD_TTT_MAX_CELLS cells are recorded; bigger ones don't fit 4-bit moves.
+GameRecord ttt_record(const MnkBoard& board) {
+    const MnkRules& r = board.rules();
+    return record_start(RECORD_TTT, record_source(), uint32_t(r.width) | uint32_t(r.height) << 8 | uint32_t(r.k) << 16);
+}
+
+void record_ttt_move(GameRecord& record, const MnkBoard& board, int cell) {
+    if (board.cells() <= RECORD_TTT_MAX_CELLS) record_pack(record, RECORD_TTT_BITS, static_cast<unsigned>(cell));
+}
+
+void record_ttt_end(GameRecord& record, const MnkBoard& board, int winner) {
+    metric_count(COUNT_TTT);
+    if (board.cells() > RECORD_TTT_MAX_CELLS) return;
+    record.outcome = static_cast<uint8_t>(winner);
+    record_played(record);
+}
+
+// The classic board as the tablebase's bitboard; both number cells row-major from 0.
+TttBoard ttt_bitboard(const MnkBoard& board) {
+    TttBoard bits;
+    for (int cell = 0; cell < 9; cell++) {
+        if (board.at(cell) == MNK_X) bits.x |= 1 << cell;
+        else if (board.at(cell) == MNK_O) bits.o |= 1 << cell;
     }
-    return false;
+    return bits;
+}
+
+// 3x3 keeps the numbered sectors; bigger boards ask for a row and a column.
+// Prompts are formatted in the frame, so a move costs no heap traffic.
+Task<int> read_board_move(const MnkBoard& board, string_view command) {
+    const MnkRules& rules = board.rules();
+    char prompt[64];
+    int length = static_cast<int>(command.size());
+    if (rules.width == 3 && rules.height == 3) {
+        snprintf(prompt, sizeof(prompt), "\n\t%.*s (1-9) > ", length, command.data());
+        co_return co_await getValidatedInt(prompt, 1, 9) - 1;
+    }
+    snprintf(prompt, sizeof(prompt), "\n\t%.*s Row (1-%d) > ", length, command.data(), rules.height);
+    int row = co_await getValidatedInt(prompt, 1, rules.height);
+    snprintf(prompt, sizeof(prompt), "\tColumn (1-%d) > ", rules.width);
+    int col = co_await getValidatedInt(prompt, 1, rules.width);
+    co_return board.index(row - 1, col - 1);
 }
 
-void tic_tac_toe_pvp() {
+Task<void> tic_tac_toe_pvp(MnkBoard& board) {
     char currentPlayer = 'X';
+    GameRecord record = ttt_record(board);
     while(true) {
         clearScreen();
         drawHeader("PvP MATCH");
-        show_board();
+        show_board(board);
         
-        cout << "\tPlayer " << currentPlayer << "'s turn.";
-        int slot = getValidatedInt("\n\tSelect Sector (1-9) > ", 1, 9);
-
-        if (place_marker(slot, currentPlayer)) {
-            char winner = check_winner();
-            if (winner != 'C') {
+        out() << "\tPlayer " << currentPlayer << "'s turn.";
+        int cell = co_await read_board_move(board, "Select Sector");
+
+        if (board.at(cell) == MNK_EMPTY) {
+            int stone = currentPlayer == 'X' ? MNK_X : MNK_O;
+            board.play(cell, stone);
+            record_ttt_move(record, board, cell);
+            bool won = board.wins_at(cell);
+            if (won || board.full()) {
+                record_ttt_end(record, board, won ? stone : MNK_EMPTY);
                 clearScreen();
                 drawHeader("GAME OVER");
-                show_board();
-                if (winner == 'D') { setColor(COLOR_YELLOW); cout << "\n\tSTALEMATE (DRAW)!\n"; }
-                else { setColor(COLOR_GREEN); cout << "\n\tPLAYER " << winner << " DOMINATED!\n"; }
+                show_board(board);
+                if (!won) { setColor(COLOR_YELLOW); out() << "\n\tSTALEMATE (DRAW)!\n"; }
+                else { setColor(COLOR_GREEN); out() << "\n\tPLAYER " << currentPlayer << " DOMINATED!\n"; }
                 setColor(COLOR_DEFAULT);
-                pauseGame();
-                return;
+                co_await pauseGame();
+                co_return;
             }
             currentPlayer = (currentPlayer == 'X') ? 'O' : 'X';
         } else {
-            setColor(COLOR_RED); cout << "\tSector Occupied!\n"; setColor(COLOR_DEFAULT);
-            this_thread::sleep_for(chrono::milliseconds(500));
+            setColor(COLOR_RED); out() << "\tSector Occupied!\n"; setColor(COLOR_DEFAULT);
+            co_await pace(500);
         }
     }
 }
 
-void tic_tac_toe_pvc() {
+Task<void> tic_tac_toe_pvc(MnkBoard& board) {
+    // One table per thread for the whole run (server sessions run on every pool worker);
+    // new_game() retires old entries without clearing 16 MB
+    thread_local MnkSearch search;
+    search.new_game();
+
+    // Classic 3x3 plays straight from the compile-time tablebase; the search and its
+    // ponder are for the bigger boards
+    const MnkRules& rules = board.rules();
+    const bool tablebase = rules.width == 3 && rules.height == 3 && rules.k == 3;
+
+    // Searches on while the human thinks; replays skip it since its depth depends on timing
+    MnkPonder ponder;
+    int winner = MNK_EMPTY;
+    GameRecord record = ttt_record(board);
+    pmr::string report(&session_arena());
     while(true) {
-        clearScreen();
-        drawHeader("MAN VS MACHINE");
-        show_board();
-        
-        // Human Move
-        int slot = getValidatedInt("\n\tYour Command (1-9) > ", 1, 9);
+        // Once per human turn: a mistyped sector keeps the search it has going
+        if (!tablebase && !replayMode && !isRemote()) ponder.start(search, board, MNK_X);
 
-        if (!place_marker(slot, 'X')) {
-            cout << "\n\tSector Invalid!";
-            this_thread::sleep_for(chrono::milliseconds(500));
-            continue;
+        // Human Move
+        int cell;
+        while (true) {
+            clearScreen();
+            drawHeader("MAN VS MACHINE");
+            show_board(board);
+            if (!report.empty()) { setColor(COLOR_CYAN); out() << "\t" << report << "\n"; setColor(COLOR_DEFAULT); }
+
+            cell = co_await read_board_move(board, "Your Command");
+            if (board.at(cell) == MNK_EMPTY) break;
+            out() << "\n\tSector Invalid!";
+            co_await pace(500);
         }
 
-        if (check_winner() != 'C') break;
+        board.play(cell, MNK_X);
+        record_ttt_move(record, board, cell);
+        if (board.wins_at(cell)) { winner = MNK_X; break; }
+        if (board.full()) break;
+
+        // AI Move: the budget is real search time now, not a cosmetic pause. Replays swap
+        // the clock for a node count so the same script always gets the same replies.
+        // A ponder hit that already used its budget (or solved the game) moves at once;
+        // a short one tops up with the rest of the budget on the warm table.
+        MnkSearchResult result;
+        bool hit = false;
+        uint64_t pondered = 0;
+        if (tablebase) {
+            MetricTimer think(METRIC_AI_TTT);
+            result.move = best_move(ttt_bitboard(board));
+        } else {
+            hit = ponder.finish(cell, result);
+            int budget = AI_BUDGETS_MS[session().aiBudget];
+            pondered = hit ? result.nodes : 0;
+            if (!hit || (!result.solved && result.seconds * 1000 < budget)) {
+                out() << "\n\tAI Calculating...";
+                terminal().present();
+                MnkLimits limits;
+                limits.milliseconds = replayMode ? 0 : max(1, budget - static_cast<int>(hit ? result.seconds * 1000 : 0));
+                limits.nodes = replayMode ? static_cast<uint64_t>(budget) * 1000 : 0;
+                // A network search runs on a pool worker other sessions are queued behind;
+                // a long one would stall them all, so it is cut short
+                if (isRemote()) limits.milliseconds = min(limits.milliseconds, SERVER_THINK_MS);
+                MetricTimer think(METRIC_AI_TTT);
+                result = search.search(board, MNK_O, limits);
+            }
+        }
+        board.play(result.move, MNK_O);
+        record_ttt_move(record, board, result.move);
 
-        // AI Move
-        cout << "\n\tAI Calculating...";
-        this_thread::sleep_for(chrono::milliseconds(600));
-        computer_turn();
+        // Rebuilt in place, so it keeps its capacity from move to move
+        report.clear();
+        if (tablebase) {
+            report += "CPU played from the tablebase";
+        } else {
+            report += "CPU searched depth ";
+            report += to_string(result.depth);
+            if (result.solved) report += " (solved)";
+            report += ", ";
+            report += to_string(result.nodes);
+            report += " nodes";
+            if (!replayMode && result.seconds > 0) {
+                report += ", ";
+                report += to_string(static_cast<long long>(result.nodes / result.seconds));
+                report += " nodes/s";
+            }
+            if (hit) {
+                report += "; ponder hit after ";
+                report += to_string(pondered);
+                report += " nodes";
+            }
+        }
 
-        if (check_winner() != 'C') break;
+        if (board.wins_at(result.move)) { winner = MNK_O; break; }
+        if (board.full()) break;
     }
+    // However the game ended, nothing searches on behind the result screen
+    ponder.stop();
     
+    record_ttt_end(record, board, winner);
+    record_stat(PLAYER_TTT, winner == MNK_X ? PLAYER_WIN : winner == MNK_O ? PLAYER_LOSS : PLAYER_DRAW);
+
     clearScreen();
     drawHeader("GAME RESULT");
-    show_board();
-    char winner = check_winner();
-    if(winner == 'X') { setColor(COLOR_GREEN); cout << "\n\tHUMANITY WINS!\n"; }
-    else if(winner == 'O') { setColor(COLOR_RED); cout << "\n\tMACHINE DOMINATION!\n"; }
-    else { setColor(COLOR_YELLOW); cout << "\n\tTACTICAL DRAW.\n"; }
+    show_board(board);
+    if(winner == MNK_X) { setColor(COLOR_GREEN); out() << "\n\tHUMANITY WINS!\n"; }
+    else if(winner == MNK_O) { setColor(COLOR_RED); out() << "\n\tMACHINE DOMINATION!\n"; }
+    else { setColor(COLOR_YELLOW); out() << "\n\tTACTICAL DRAW.\n"; }
     setColor(COLOR_DEFAULT);
-    pauseGame();
-}
-
-// Simple AI: Prioritizes center, then random available spots
-void computer_turn() {
-    if(board[4] == ' ') { board[4] = 'O'; return; } 
-
-    int slot;
-    while(true) {
-        slot = rand() % 9;
-        if (board[slot] == ' ') {
-            board[slot] = 'O';
-            break;
-        }
-    }
-}
-
-char check_winner() {
-    // Horizontal & Vertical Checks
-    for(int i=0; i<3; i++) {
-        if(board[i*3] == board[i*3+1] && board[i*3+1] == board[i*3+2] && board[i*3] != ' ') return board[i*3];
-        if(board[i] == board[i+3] && board[i+3] == board[i+6] && board[i] != ' ') return board[i];
-    }
-    // Diagonal Checks
-    if (board[0] == board[4] && board[4] == board[8] && board[0] != ' ') return board[0];
-    if (board[2] == board[4] && board[4] == board[6] && board[2] != ' ') return board[2];
-
-    int filled = 0;
-    for(int i=0; i<9; i++) if(board[i] != ' ') filled++;
-    
-    if (filled == 9) return 'D'; // Draw
-    return 'C'; // Continue
-}
-
-void clearboard() {
-    for (int i = 0; i < 9; i++) board[i] = ' ';
+    co_await pauseGame();
 }
 
 // --- 4. ROCK PAPER SCISSORS ---
 
-void rock_paper_scissors() {
-    string moves[3] = {"Rock", "Paper", "Scissors"};
+Task<void> rock_paper_scissors() {
+    static const char* const moves[3] = {"Rock", "Paper", "Scissors"};
+    RpsBrain cpu(RPS_MIXTURE);  // Learns the player's habits for as long as they stay
+    const uint32_t sides = RECORD_HUMAN | uint32_t(RPS_MIXTURE) << 8;
+    GameRecord record = record_start(RECORD_RPS, record_source(), sides);
+    uint32_t rounds = 0, wins = 0;
     while(true) {
         clearScreen();
         drawHeader("R.P.S BATTLE");
         
-        cout << "\t[1] Rock\n\t[2] Paper\n\t[3] Scissors\n\t[0] Return\n";
+        out() << "\t[1] Rock\n\t[2] Paper\n\t[3] Scissors\n\t[0] Return\n";
         
-        int pMove = getValidatedInt("\n\tWeapon Choice > ", 0, 3);
-        if (pMove == 0) break;
+        int pMove = co_await getValidatedInt("\n\tWeapon Choice > ", 0, 3);
+        if (pMove == 0) {
+            if (record.count) record_played(record);
+            if (rounds) record_stat(PLAYER_RPS, rounds, wins);
+            break;
+        }
         pMove--; // Convert to 0-index
 
-        cout << "\n\tYou deployed: " << moves[pMove] << "\n";
+        out() << "\n\tYou deployed: " << moves[pMove] << "\n";
         
-        int cMove = rand() % 3;
-        cout << "\tCPU deployed: " << moves[cMove] << "\n";
+        int cMove;
+        {
+            MetricTimer think(METRIC_AI_RPS);
+            cMove = cpu.choose(threadRng());
+        }
+        cpu.observe(cMove, pMove);
+        out() << "\tCPU deployed: " << moves[cMove] << "\n";
         
-        this_thread::sleep_for(chrono::milliseconds(500));
+        co_await pace(500);
         drawDivider();
 
-        if (pMove == cMove) {
-            setColor(COLOR_YELLOW); cout << "\n\tEFFECT: NO DAMAGE (TIE)\n";
+        RpsOutcome outcome = rps_resolve(pMove, cMove);
+        record_pack(record, RECORD_RPS_BITS, static_cast<unsigned>(pMove | cMove << 2));
+        if (outcome == RPS_WIN) record.outcome++;
+        rounds++;
+        if (outcome == RPS_WIN) wins++;
+        metric_count(COUNT_RPS);
+        if (record.count == RECORD_RPS_ROUNDS) {
+            record_played(record);
+            record = record_start(RECORD_RPS, record_source(), sides);
+        }
+        if (outcome == RPS_TIE) {
+            setColor(COLOR_YELLOW); out() << "\n\tEFFECT: NO DAMAGE (TIE)\n";
         }
-        else if ((pMove == 0 && cMove == 2) || (pMove == 1 && cMove == 0) || (pMove == 2 && cMove == 1)) {
-            setColor(COLOR_GREEN); cout << "\n\tEFFECT: CRITICAL HIT (WIN)\n";
+        else if (outcome == RPS_WIN) {
+            setColor(COLOR_GREEN); out() << "\n\tEFFECT: CRITICAL HIT (WIN)\n";
         } else {
-            setColor(COLOR_RED); cout << "\n\tEFFECT: DEFEAT\n";
+            setColor(COLOR_RED); out() << "\n\tEFFECT: DEFEAT\n";
         }
         setColor(COLOR_DEFAULT);
-        pauseGame();
+        co_await pauseGame();
     }
 }
 
@@ -473,89 +1332,124 @@ void rock_paper_scissors() {
 
 void drawHangman(int lives) {
     setColor(COLOR_RED);
-    cout << "\n\t  _______";
-    cout << "\n\t  |     |";
-    cout << "\n\t  |     " << (lives < 6 ? "O" : "");
-    cout << "\n\t  |    " << (lives < 4 ? "/" : " ") << (lives < 5 ? "|" : "") << (lives < 3 ? "\\" : "");
-    cout << "\n\t  |    " << (lives < 2 ? "/" : " ") << " " << (lives < 1 ? "\\" : "");
-    cout << "\n\t__|__\n";
+    out() << "\n\t  _______";
+    out() << "\n\t  |     |";
+    out() << "\n\t  |     " << (lives < 6 ? "O" : "");
+    out() << "\n\t  |    " << (lives < 4 ? "/" : " ") << (lives < 5 ? "|" : "") << (lives < 3 ? "\\" : "");
+    out() << "\n\t  |    " << (lives < 2 ? "/" : " ") << " " << (lives < 1 ? "\\" : "");
+    out() << "\n\t__|__\n";
     setColor(COLOR_DEFAULT);
 }
 
-void hangman_game() {
-    // Dictionary of possible words
-    vector<string> words = {"PROGRAMMING", "COMPUTER", "KEYBOARD", "DEVELOPER", "ALGORITHM", "VARIABLE", "POINTER"};
-    string secretWord = words[rand() % words.size()];
-    string guessWord(secretWord.length(), '_');
-    int lives = 6;
-    vector<char> guessedChars;
-
-    while (lives > 0 && guessWord != secretWord) {
+Task<void> hangman_game() {
+    string& inputLine = session().inputLine;
+    clearScreen();
+    drawHeader("HANGMAN SURVIVAL");
+    const HangmanDictionary& dictionary = hangman_dictionary();    // A --dict still loading is waited for here
+    if (!hangman_dictionary_error().empty()) {
+        setColor(COLOR_YELLOW); out() << "\t[!] Dictionary not loaded (" << hangman_dictionary_error() << "); using the built-in words.\n\n"; setColor(COLOR_DEFAULT);
+    }
+    out() << "\t[1] Easy\n\t[2] Medium\n\t[3] Hard\n\t[4] Any\n\t[0] Return\n";
+    int level = co_await getValidatedInt("\n\tDifficulty > ", 0, 4);
+    if (level == 0) co_return;
+
+    // Straight from the indexed dictionary; only the chosen word is copied
+    const HangmanEntry* entry = dictionary.pick(threadRng(), level == 4 ? HANGMAN_ANY : level - 1);
+    if (!entry) {
+        setColor(COLOR_RED); out() << "\n\t[!] No words at this difficulty in the dictionary.\n"; setColor(COLOR_DEFAULT);
+        co_await pauseGame();
+        co_return;
+    }
+    pmr::string secretWord(dictionary.word(*entry), &session_arena());
+    for (char& c : secretWord) c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+    HangmanGame game;
+    game.word = hangman_word(secretWord);
+    GameRecord record = record_start(RECORD_HANGMAN, record_source(), game.word.letters | uint32_t(game.word.length) << 26);
+    HangmanSolver solver;       // Set up on the first hint, then kept in step with each guess
+    bool solverReady = false;
+    int hintLetter = -1;        // Shown with the board until the next guess
+
+    while (game.lives > 0 && !hangman_solved(game)) {
         clearScreen();
         drawHeader("HANGMAN SURVIVAL");
-        drawHangman(lives);
+        drawHangman(game.lives);
         
-        cout << "\n\tLives: " << lives;
-        cout << "\n\tWord:  ";
+        out() << "\n\tLives: " << game.lives;
+        out() << "\n\tWord:  ";
         
         setColor(COLOR_BLUE);
-        for(char c : guessWord) cout << c << " ";
+        for (int i = 0; i < game.word.length; i++) out() << (game.revealed >> i & 1 ? secretWord[i] : '_') << " ";
         setColor(COLOR_DEFAULT);
 
-        cout << "\n\n\tHistory: ";
-        for(char c : guessedChars) cout << c << " ";
-
-        cout << "\n\n\tEnter Char > ";
-        string input;
-        getline(cin, input);
+        out() << "\n\n\tHistory: ";
+        for (int letter = 0; letter < 26; letter++) if (game.guessed >> letter & 1) out() << char('A' + letter) << " ";
+        if (hintLetter >= 0) {
+            setColor(COLOR_YELLOW);
+            out() << "\n\tCPU suggests '" << char('A' + hintLetter) << "' (" << solver.candidates()
+                  << (solver.candidates() == 1 ? " dictionary word fits)" : " dictionary words fit)");
+            setColor(COLOR_DEFAULT);
+        }
 
-        if(input.length() != 1 || !isalpha(input[0])) {
-            cout << "\t[!] Single letter input required.";
-            this_thread::sleep_for(chrono::seconds(1));
+        out() << "\n\n\tEnter Char (? = hint) > ";
+        co_await readLine(inputLine, true);
+
+        if (inputLine == "?") {
+            MetricTimer think(METRIC_AI_HANGMAN);
+            if (!solverReady) {
+                solver.reset(hangman_solver_index(), game.word.length);
+                for (int letter = 0; letter < 26; letter++) {
+                    if (game.guessed >> letter & 1) solver.observe(letter, game.word.positions[letter]);
+                }
+                solverReady = true;
+            }
+            hintLetter = solver.next_guess();
             continue;
         }
 
-        char guess = toupper(input[0]);
-        
-        bool alreadyGuessed = false;
-        for(char c : guessedChars) if(c == guess) alreadyGuessed = true;
-        
-        if(alreadyGuessed) {
-            cout << "\t[!] Already attempted.";
-            this_thread::sleep_for(chrono::seconds(1));
+        if(inputLine.length() != 1 || !isalpha(static_cast<unsigned char>(inputLine[0]))) {
+            out() << "\t[!] Single letter input required.";
+            co_await pace(1000);
             continue;
         }
 
-        guessedChars.push_back(guess);
-
-        bool found = false;
-        for (size_t i = 0; i < secretWord.length(); i++) {
-            if (secretWord[i] == guess) {
-                guessWord[i] = guess;
-                found = true;
-            }
+        int letter = toupper(static_cast<unsigned char>(inputLine[0])) - 'A';
+        HangmanGuess result = hangman_guess(game, letter);
+        if (solverReady && result != HANGMAN_REPEAT) solver.observe(letter, game.word.positions[letter]);
+        if (result != HANGMAN_REPEAT) {
+            hintLetter = -1;
+            record_pack(record, RECORD_HANGMAN_BITS, static_cast<unsigned>(letter));
+        }
+        
+        if (result == HANGMAN_REPEAT) {
+            out() << "\t[!] Already attempted.";
+            co_await pace(1000);
+            continue;
         }
 
-        if (found) {
-            setColor(COLOR_GREEN); cout << "\n\tMatch Found!"; setColor(COLOR_DEFAULT);
+        if (result == HANGMAN_HIT) {
+            setColor(COLOR_GREEN); out() << "\n\tMatch Found!"; setColor(COLOR_DEFAULT);
         } else {
-            setColor(COLOR_RED); cout << "\n\tIncorrect!"; setColor(COLOR_DEFAULT);
-            lives--;
+            setColor(COLOR_RED); out() << "\n\tIncorrect!"; setColor(COLOR_DEFAULT);
         }
-        this_thread::sleep_for(chrono::milliseconds(800));
+        co_await pace(800);
     }
 
+    record.outcome = static_cast<uint8_t>(HangmanGame().lives - game.lives);    // Misses
+    record_played(record);
+    record_stat(PLAYER_HANGMAN, game.lives > 0 ? 1 : 0);
+    metric_count(COUNT_HANGMAN);
+
     clearScreen();
-    drawHeader(lives > 0 ? "MISSION ACCOMPLISHED" : "MISSION FAILED");
-    drawHangman(lives);
+    drawHeader(game.lives > 0 ? "MISSION ACCOMPLISHED" : "MISSION FAILED");
+    drawHangman(game.lives);
     
-    if (lives > 0) {
+    if (game.lives > 0) {
         setColor(COLOR_GREEN);
-        cout << "\n\tYou survived! Word: " << secretWord << "\n";
+        out() << "\n\tYou survived! Word: " << secretWord << "\n";
     } else {
         setColor(COLOR_RED);
-        cout << "\n\tEliminated. Word: " << secretWord << "\n";
+        out() << "\n\tEliminated. Word: " << secretWord << "\n";
     }
     setColor(COLOR_DEFAULT);
-    pauseGame();
+    co_await pauseGame();
 }
\ No newline at end of file
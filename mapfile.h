@@ -0,0 +1,100 @@
+/**
+ * ======================================================================================
+ * MAPPED FILES
+ * Read-only memory maps for data files (dictionaries, their indexes). The OS pages the
+ * file in on demand, so opening a large file costs nothing until it is actually read.
+ * ======================================================================================
+ */
+
+#ifndef GAMEHUB_MAPFILE_H
+#define GAMEHUB_MAPFILE_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { close(); }
+
+    // Maps the whole file read-only. An empty file opens fine with data() == nullptr.
+    bool open(const std::string& path) {
+        close();
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER bytes;
+        if (!GetFileSizeEx(file, &bytes)) { close(); return false; }
+        length = static_cast<std::size_t>(bytes.QuadPart);
+        if (length == 0) return true;
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) { close(); return false; }
+        base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!base) { close(); return false; }
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0) { ::close(fd); return false; }
+        length = static_cast<std::size_t>(st.st_size);
+        if (length > 0) {
+            base = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (base == MAP_FAILED) base = nullptr;
+        }
+        ::close(fd);    // The mapping keeps its own reference
+        if (length > 0 && !base) { length = 0; return false; }
+#endif
+        return true;
+    }
+
+    void close() {
+#ifdef _WIN32
+        if (base) UnmapViewOfFile(base);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+        mapping = nullptr;
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (base) munmap(base, length);
+#endif
+        base = nullptr;
+        length = 0;
+    }
+
+    void swap(MappedFile& other) {
+        std::swap(base, other.base);
+        std::swap(length, other.length);
+#ifdef _WIN32
+        std::swap(file, other.file);
+        std::swap(mapping, other.mapping);
+#endif
+    }
+
+    const char* data() const { return static_cast<const char*>(base); }
+    std::size_t size() const { return length; }
+
+private:
+    void* base = nullptr;
+    std::size_t length = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+};
+
+#endif
@@ -0,0 +1,250 @@
+/**
+ * ======================================================================================
+ * METRICS
+ * Where the time goes: latency histograms for input waits, parsing, rendering and CPU
+ * thinking, and counters for games finished per module. Every thread writes its own
+ * shard with plain relaxed stores, so recording takes no lock and shares no cache
+ * line; a report sums the shards. Histograms are HDR-style: 16 linear sub-buckets per
+ * power of two, so any quantile is within about 6% from a nanosecond up to minutes.
+ * Off unless `--stats` or `--stats-port` is given; a disabled timer is one branch.
+ * ======================================================================================
+ */
+
+#ifndef GAMEHUB_METRICS_H
+#define GAMEHUB_METRICS_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+enum Metric {
+    METRIC_INPUT_WAIT,          // Prompt shown until the answer is in
+    METRIC_INPUT_PARSE,         // Validating that answer
+    METRIC_RENDER_CLEAR,
+    METRIC_RENDER_HEADER,
+    METRIC_RENDER_BOARD,
+    METRIC_RENDER_PRESENT,      // Diffing and writing out a frame
+    METRIC_AI_TTT,              // CPU move search
+    METRIC_AI_RPS,
+    METRIC_AI_HANGMAN,          // Hint
+    METRIC_STARTUP,             // Process start until the first menu is on screen
+    METRIC_COUNT
+};
+
+enum Counter {
+    COUNT_DICE,
+    COUNT_SECRET,
+    COUNT_TTT,
+    COUNT_RPS,                  // Rounds
+    COUNT_HANGMAN,
+    COUNT_SIM_TTT,
+    COUNT_SIM_RPS,
+    COUNT_SIM_SECRET,
+    COUNT_SIM_HANGMAN,
+    COUNT_SIM_DICE,             // Rolls
+    COUNTER_COUNT
+};
+
+inline const char* metric_name(int m) {
+    static const char* const NAMES[METRIC_COUNT] = {
+        "input.wait", "input.parse", "render.clear", "render.header", "render.board", "render.present",
+        "ai.ttt", "ai.rps", "ai.hangman", "startup",
+    };
+    return NAMES[m];
+}
+
+inline const char* counter_name(int c) {
+    static const char* const NAMES[COUNTER_COUNT] = {
+        "games.dice", "games.secret", "games.ttt", "rounds.rps", "games.hangman",
+        "sim.ttt", "sim.rps", "sim.secret", "sim.hangman", "sim.dice",
+    };
+    return NAMES[c];
+}
+
+// --- HISTOGRAM BUCKETS ---
+
+constexpr int METRIC_SUB_BITS = 4;
+constexpr int METRIC_SUB = 1 << METRIC_SUB_BITS;
+constexpr int METRIC_MAX_EXP = 40;      // 2^40 ns is about 18 minutes; longer values land in the top bucket
+constexpr int METRIC_BUCKETS = (METRIC_MAX_EXP - METRIC_SUB_BITS + 2) * METRIC_SUB;
+
+// Values below METRIC_SUB get a bucket each; above, a bucket spans 1/16 of its octave.
+inline int metric_bucket(std::uint64_t ns) {
+    if (ns < std::uint64_t(METRIC_SUB)) return static_cast<int>(ns);
+    int exp = std::bit_width(ns) - 1;
+    if (exp > METRIC_MAX_EXP) return METRIC_BUCKETS - 1;
+    return (exp - METRIC_SUB_BITS + 1) * METRIC_SUB + static_cast<int>((ns >> (exp - METRIC_SUB_BITS)) & (METRIC_SUB - 1));
+}
+
+// The smallest value that lands in `bucket`.
+inline std::uint64_t metric_bucket_floor(int bucket) {
+    if (bucket < METRIC_SUB) return static_cast<std::uint64_t>(bucket);
+    int exp = bucket / METRIC_SUB + METRIC_SUB_BITS - 1;
+    return (std::uint64_t(METRIC_SUB) + std::uint64_t(bucket % METRIC_SUB)) << (exp - METRIC_SUB_BITS);
+}
+
+// --- SHARDS ---
+
+// One thread's numbers. Only the owner writes (load + store, no read-modify-write);
+// reports read them relaxed while the owner carries on.
+struct MetricShard {
+    std::atomic<std::uint64_t> buckets[METRIC_COUNT][METRIC_BUCKETS] = {};
+    std::atomic<std::uint64_t> total[METRIC_COUNT] = {};
+    std::atomic<std::uint64_t> highest[METRIC_COUNT] = {};
+    std::atomic<std::uint64_t> counters[COUNTER_COUNT] = {};
+};
+
+inline void metric_bump(std::atomic<std::uint64_t>& slot, std::uint64_t by) {
+    slot.store(slot.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+}
+
+// Shards outlive their threads, so nothing counted is lost when a thread exits.
+struct MetricRegistry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<MetricShard>> shards;
+    std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+};
+
+inline MetricRegistry& metric_registry() {
+    static MetricRegistry registry;
+    return registry;
+}
+
+inline bool& metrics_enabled() {
+    static bool enabled = false;    // Set while parsing options, before any thread starts
+    return enabled;
+}
+
+// Turns recording on and starts the uptime clock. Call while parsing options.
+inline void metrics_start() {
+    metrics_enabled() = true;
+    metric_registry();
+}
+
+inline MetricShard& metric_shard() {
+    thread_local MetricShard* shard = nullptr;
+    if (!shard) {
+        MetricRegistry& r = metric_registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.shards.emplace_back(new MetricShard());
+        shard = r.shards.back().get();
+    }
+    return *shard;
+}
+
+inline void metric_record(Metric m, std::uint64_t ns) {
+    MetricShard& s = metric_shard();
+    metric_bump(s.buckets[m][metric_bucket(ns)], 1);
+    metric_bump(s.total[m], ns);
+    if (ns > s.highest[m].load(std::memory_order_relaxed)) s.highest[m].store(ns, std::memory_order_relaxed);
+}
+
+inline void metric_count(Counter c, std::uint64_t by = 1) {
+    if (metrics_enabled()) metric_bump(metric_shard().counters[c], by);
+}
+
+inline std::uint64_t metric_now() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// For spans that don't fit a scope: from `start` until now.
+inline void metric_record_since(Metric m, std::chrono::steady_clock::time_point start) {
+    if (metrics_enabled()) {
+        metric_record(m, static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count()));
+    }
+}
+
+// Times its own scope. Disabled, it never reads the clock.
+class MetricTimer {
+public:
+    explicit MetricTimer(Metric m) : metric(m), start(metrics_enabled() ? metric_now() : 0) {}
+    MetricTimer(const MetricTimer&) = delete;
+    MetricTimer& operator=(const MetricTimer&) = delete;
+    ~MetricTimer() { if (start) metric_record(metric, metric_now() - start); }
+
+private:
+    Metric metric;
+    std::uint64_t start;
+};
+
+// --- REPORT ---
+
+struct MetricSummary {
+    std::uint64_t count = 0, total = 0, highest = 0;
+    std::uint64_t buckets[METRIC_BUCKETS] = {};
+
+    // Lower edge of the bucket holding quantile q, capped at the largest value seen.
+    std::uint64_t quantile(double q) const {
+        if (count == 0) return 0;
+        std::uint64_t rank = static_cast<std::uint64_t>(q * static_cast<double>(count - 1)) + 1, seen = 0;
+        for (int b = 0; b < METRIC_BUCKETS; b++) {
+            seen += buckets[b];
+            if (seen >= rank) return std::min(metric_bucket_floor(b), highest);
+        }
+        return highest;
+    }
+};
+
+inline MetricSummary metric_summary(Metric m) {
+    MetricSummary s;
+    MetricRegistry& r = metric_registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (const auto& shard : r.shards) {
+        for (int b = 0; b < METRIC_BUCKETS; b++) {
+            std::uint64_t n = shard->buckets[m][b].load(std::memory_order_relaxed);
+            s.buckets[b] += n;
+            s.count += n;
+        }
+        s.total += shard->total[m].load(std::memory_order_relaxed);
+        s.highest = std::max(s.highest, shard->highest[m].load(std::memory_order_relaxed));
+    }
+    return s;
+}
+
+inline std::uint64_t metric_counter(Counter c) {
+    std::uint64_t sum = 0;
+    MetricRegistry& r = metric_registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (const auto& shard : r.shards) sum += shard->counters[c].load(std::memory_order_relaxed);
+    return sum;
+}
+
+// One line per metric with samples, times in microseconds; then counters with their
+// rate over the whole run. Keys are stable, so the output can be scraped or diffed.
+inline void metrics_report(std::ostream& os) {
+    std::ios saved(nullptr);
+    saved.copyfmt(os);
+    double uptime = std::chrono::duration<double>(std::chrono::steady_clock::now() - metric_registry().started).count();
+    os << "[STATS] uptime " << std::fixed << std::setprecision(3) << uptime << " s\n";
+    os << "[STATS] " << std::left << std::setw(16) << "metric" << std::right << std::setw(10) << "count"
+       << std::setw(12) << "mean_us" << std::setw(12) << "p50_us" << std::setw(12) << "p90_us"
+       << std::setw(12) << "p99_us" << std::setw(12) << "p999_us" << std::setw(12) << "max_us" << "\n";
+    for (int m = 0; m < METRIC_COUNT; m++) {
+        MetricSummary s = metric_summary(Metric(m));
+        if (s.count == 0) continue;
+        auto us = [](std::uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+        os << "[STATS] " << std::left << std::setw(16) << metric_name(m) << std::right << std::setw(10) << s.count
+           << std::setprecision(2) << std::setw(12) << us(s.total) / static_cast<double>(s.count)
+           << std::setw(12) << us(s.quantile(0.50)) << std::setw(12) << us(s.quantile(0.90))
+           << std::setw(12) << us(s.quantile(0.99)) << std::setw(12) << us(s.quantile(0.999))
+           << std::setw(12) << us(s.highest) << "\n";
+    }
+    for (int c = 0; c < COUNTER_COUNT; c++) {
+        std::uint64_t n = metric_counter(Counter(c));
+        if (n == 0) continue;
+        os << "[STATS] " << std::left << std::setw(16) << counter_name(c) << std::right << std::setw(10) << n
+           << std::setprecision(1) << std::setw(14) << (uptime > 0 ? static_cast<double>(n) / uptime : 0.0) << " /s\n";
+    }
+    os.copyfmt(saved);
+}
+
+#endif
@@ -0,0 +1,460 @@
+/**
+ * ======================================================================================
+ * M,N,K ENGINE
+ * Tic-Tac-Toe generalized to any board up to 19x19 and any run length up to 7 (4x4,
+ * 5x5 with 4 in a row, 15x15 gomoku, ...), with an iterative-deepening alpha-beta
+ * search behind a Zobrist-keyed transposition table and a per-move time budget.
+ * The classic 3x3 tablebase in ttt.h stays the reference for the simulator.
+ * ======================================================================================
+ */
+
+#ifndef GAMEHUB_MNK_H
+#define GAMEHUB_MNK_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <memory_resource>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "rng.h"
+
+struct MnkRules {
+    int width = 3;
+    int height = 3;
+    int k = 3;          // Stones in a row needed to win
+};
+
+constexpr int MNK_MAX_SIDE = 19;
+constexpr int MNK_MAX_K = 7;
+constexpr int MNK_MAX_CELLS = MNK_MAX_SIDE * MNK_MAX_SIDE;
+constexpr int MNK_WIN = 1 << 29;            // Minus the plies it takes; heuristics stay far below
+constexpr int MNK_WIN_BOUND = MNK_WIN - MNK_MAX_CELLS - 1;
+
+enum MnkStone { MNK_EMPTY = 0, MNK_X = 1, MNK_O = 2 };
+
+inline bool mnk_valid(const MnkRules& r) {
+    return r.width >= 1 && r.height >= 1 && r.width <= MNK_MAX_SIDE && r.height <= MNK_MAX_SIDE &&
+           r.k >= 2 && r.k <= MNK_MAX_K && r.k <= std::max(r.width, r.height);
+}
+
+// Board plus the incremental bookkeeping the search leans on: every k-long window
+// tracks how many stones of each side it holds, which gives the evaluation, the move
+// ordering and the win test without rescanning the board.
+class MnkBoard {
+public:
+    // All of the board's storage comes from `memory`; a game's board can live in its
+    // session arena (arena.h).
+    explicit MnkBoard(MnkRules r = MnkRules(), std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+        : rules_(r), grid(memory), near(memory), counts{ Counts(memory), Counts(memory) },
+          windowStart(memory), windowList(memory), zobrist(memory) {
+        int cells = r.width * r.height;
+        grid.assign(cells, MNK_EMPTY);
+        near.assign(cells, 0);
+
+        // Windows along rows, columns and both diagonals, and for each cell the
+        // windows that pass through it (compressed rows): one pass to size each row,
+        // one to fill them in.
+        static const int DIRS[4][2] = { {0, 1}, {1, 0}, {1, 1}, {1, -1} };
+        auto each_window = [&r](auto&& visit) {
+            int w = 0;
+            for (const auto& d : DIRS) {
+                for (int row = 0; row < r.height; row++) {
+                    for (int col = 0; col < r.width; col++) {
+                        int endRow = row + d[0] * (r.k - 1), endCol = col + d[1] * (r.k - 1);
+                        if (endRow >= r.height || endCol < 0 || endCol >= r.width) continue;
+                        for (int i = 0; i < r.k; i++) visit(w, (row + d[0] * i) * r.width + col + d[1] * i);
+                        w++;
+                    }
+                }
+            }
+            return w;
+        };
+        windowStart.assign(cells + 1, 0);
+        int windows = each_window([this](int, int cell) { windowStart[cell + 1]++; });
+        for (int c = 0; c < cells; c++) windowStart[c + 1] += windowStart[c];
+        windowList.resize(windowStart[cells]);
+        std::pmr::vector<int> fill(windowStart.begin(), windowStart.end() - 1, memory);
+        each_window([this, &fill](int w, int cell) { windowList[fill[cell]++] = w; });
+        counts[0].assign(windows, 0);
+        counts[1].assign(windows, 0);
+
+        weight[0] = 0;
+        for (int n = 1; n <= MNK_MAX_K; n++) weight[n] = 1 << (3 * (n - 1));
+
+        // Keys depend on the rules too, so equal cell indices on different boards differ.
+        std::uint64_t seed = 0x6D6E6B5A6F627269ULL ^ (std::uint64_t(r.width) << 16 | std::uint64_t(r.height) << 8 | std::uint64_t(r.k));
+        zobrist.resize(2 * cells);
+        for (std::uint64_t& key : zobrist) key = splitmix64(seed);
+    }
+
+    const MnkRules& rules() const { return rules_; }
+    int cells() const { return static_cast<int>(grid.size()); }
+    int index(int row, int col) const { return row * rules_.width + col; }
+    int at(int cell) const { return grid[cell]; }
+    int stones() const { return placed; }
+    bool full() const { return placed == cells(); }
+    std::uint64_t hash() const { return key; }
+
+    // Any stone within two cells (Chebyshev distance); where new moves are worth trying.
+    bool near_stone(int cell) const { return near[cell] > 0; }
+
+    void play(int cell, int player) { place(cell, player, +1); }
+    void undo(int cell) { place(cell, grid[cell], -1); }
+
+    // True when the stone on `cell` is part of k (or more) in a row.
+    bool wins_at(int cell) const {
+        int owner = grid[cell];
+        if (owner == MNK_EMPTY) return false;
+        static const int DIRS[4][2] = { {0, 1}, {1, 0}, {1, 1}, {1, -1} };
+        int row = cell / rules_.width, col = cell % rules_.width;
+        for (const auto& d : DIRS) {
+            int run = 1;
+            for (int s = -1; s <= 1; s += 2) {
+                int r = row + s * d[0], c = col + s * d[1];
+                while (r >= 0 && r < rules_.height && c >= 0 && c < rules_.width && grid[index(r, c)] == owner) {
+                    run++;
+                    r += s * d[0];
+                    c += s * d[1];
+                }
+            }
+            if (run >= rules_.k) return true;
+        }
+        return false;
+    }
+
+    // Static evaluation from `player`'s side: open windows weighted by how full they are.
+    int score(int player) const { return player == MNK_X ? evalX : -evalX; }
+
+    // Move-ordering estimate for `player` playing `cell`: what it builds plus what it
+    // blocks, with completing a run and stopping one ranked above everything else.
+    int move_value(int cell, int player) const {
+        int mine = player - 1, theirs = 2 - player;
+        int value = 0;
+        for (int i = windowStart[cell]; i < windowStart[cell + 1]; i++) {
+            int w = windowList[i];
+            int own = counts[mine][w], opp = counts[theirs][w];
+            if (opp == 0) value += own + 1 == rules_.k ? (1 << 28) : weight[own + 1];
+            if (own == 0) value += opp + 1 == rules_.k ? (1 << 26) : weight[opp + 1];
+        }
+        return value;
+    }
+
+private:
+    int contribution(int w) const {
+        int x = counts[0][w], o = counts[1][w];
+        if (o == 0) return weight[x];
+        if (x == 0) return -weight[o];
+        return 0;
+    }
+
+    void place(int cell, int player, int delta) {
+        int side = player - 1;
+        for (int i = windowStart[cell]; i < windowStart[cell + 1]; i++) {
+            int w = windowList[i];
+            evalX -= contribution(w);
+            counts[side][w] = static_cast<std::uint8_t>(counts[side][w] + delta);
+            evalX += contribution(w);
+        }
+        grid[cell] = static_cast<std::uint8_t>(delta > 0 ? player : MNK_EMPTY);
+        key ^= zobrist[2 * cell + side];
+        placed += delta;
+
+        int row = cell / rules_.width, col = cell % rules_.width;
+        for (int r = std::max(0, row - 2); r <= std::min(rules_.height - 1, row + 2); r++) {
+            for (int c = std::max(0, col - 2); c <= std::min(rules_.width - 1, col + 2); c++) near[index(r, c)] += delta;
+        }
+    }
+
+    using Counts = std::pmr::vector<std::uint8_t>;
+
+    MnkRules rules_;
+    std::pmr::vector<std::uint8_t> grid;
+    std::pmr::vector<int> near;
+    Counts counts[2];                       // Per window: X stones, O stones
+    std::pmr::vector<int> windowStart, windowList;
+    std::pmr::vector<std::uint64_t> zobrist;
+    int weight[MNK_MAX_K + 1];
+    int evalX = 0;
+    int placed = 0;
+    std::uint64_t key = 0;
+};
+
+// --- SEARCH ---
+
+// Stop after `milliseconds` (0 = no clock) or `nodes` (0 = no cap), or once `stop` is
+// raised from another thread. A node cap makes the search reproducible, which replays
+// rely on.
+struct MnkLimits {
+    int milliseconds = 600;
+    std::uint64_t nodes = 0;
+    const std::atomic<bool>* stop = nullptr;
+};
+
+struct MnkSearchResult {
+    int move = -1;
+    int score = 0;
+    int depth = 0;              // Last fully searched depth
+    bool solved = false;        // Score is the game-theoretic value (full-width boards only)
+    std::uint64_t nodes = 0;
+    double seconds = 0;
+};
+
+// Boards bigger than this are searched selectively: past the root only the best few
+// moves by move_value() are tried (the root always gets every candidate).
+constexpr int MNK_FULL_WIDTH_CELLS = 25;
+constexpr int MNK_BEAM = 12;
+
+class MnkSearch {
+public:
+    // 2^ttBits entries of 16 bytes, allocated once.
+    explicit MnkSearch(int ttBits = 20) : table(std::size_t(1) << ttBits), mask((std::size_t(1) << ttBits) - 1) {
+        new_game();
+    }
+
+    // Invalidates every stored entry in O(1): keys are salted per game, so entries
+    // from earlier games simply never match again.
+    void new_game() {
+        std::uint64_t state = ++generation;
+        salt = splitmix64(state);
+        std::fill(std::begin(history), std::end(history), 0);
+    }
+
+    MnkSearchResult search(MnkBoard& board, int player, const MnkLimits& limits) {
+        start = Clock::now();
+        deadline = start + std::chrono::milliseconds(limits.milliseconds);
+        useClock = limits.milliseconds > 0;
+        nodeCap = limits.nodes;
+        stopFlag = limits.stop;
+        nodes = 0;
+        aborted = false;
+        fullWidth = board.cells() <= MNK_FULL_WIDTH_CELLS;
+
+        MnkSearchResult result;
+        int moves[MNK_MAX_CELLS];
+        if (generate(board, player, -1, moves, true) == 0) return result;
+        result.move = moves[0];     // Always something legal, even with no time at all
+
+        int empties = board.cells() - board.stones();
+        for (int depth = 1; depth <= empties; depth++) {
+            rootMove = -1;
+            int score = negamax(board, player, depth, -MNK_WIN, MNK_WIN, 0);
+            if (aborted) {
+                if (rootMove >= 0) result.move = rootMove;  // Best fully searched root move so far
+                break;
+            }
+            result.move = rootMove;
+            result.score = score;
+            result.depth = depth;
+            // A win or loss inside the beam proves nothing about the replies it cut,
+            // so selective boards deepen on until the budget runs out
+            if (fullWidth && (std::abs(score) >= MNK_WIN_BOUND || depth == empties)) {
+                result.solved = true;
+                break;
+            }
+            // The next iteration costs several times this one; don't start what can't finish
+            if (useClock && Clock::now() - start > (deadline - start) / 3) break;
+        }
+
+        result.nodes = nodes;
+        result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        return result;
+    }
+
+    // The stored best move for the side to move in `board`, or -1 if there is none.
+    // Right after a search, probing the position behind its chosen move gives the
+    // reply it expects from the opponent.
+    int table_move(const MnkBoard& board) const {
+        std::uint64_t key = board.hash() ^ salt;
+        const Entry& entry = table[key & mask];
+        if (entry.key != key || entry.move < 0 || board.at(entry.move) != MNK_EMPTY) return -1;
+        return entry.move;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    enum Bound : std::uint8_t { EXACT, LOWER, UPPER };
+
+    struct Entry {
+        std::uint64_t key = 0;
+        std::int32_t score = 0;
+        std::int16_t move = -1;
+        std::uint8_t depth = 0;
+        std::uint8_t bound = EXACT;
+    };
+    static_assert(sizeof(Entry) == 16, "transposition entries are sized for the table budget");
+
+    // Win scores count plies from the root; stored relative to the node instead.
+    static int to_table(int score, int ply) {
+        return score >= MNK_WIN_BOUND ? score + ply : score <= -MNK_WIN_BOUND ? score - ply : score;
+    }
+    static int from_table(int score, int ply) {
+        return score >= MNK_WIN_BOUND ? score - ply : score <= -MNK_WIN_BOUND ? score + ply : score;
+    }
+
+    bool out_of_budget() {
+        if (nodeCap && nodes >= nodeCap) return true;
+        if (stopFlag && stopFlag->load(std::memory_order_relaxed)) return true;
+        return useClock && Clock::now() >= deadline;
+    }
+
+    // Candidate moves, best first: the table move, then by move_value(). Small boards
+    // try every empty cell; big ones only cells near existing stones.
+    int generate(const MnkBoard& board, int player, int ttMove, int* moves, bool root) {
+        std::pair<int, int> scored[MNK_MAX_CELLS];
+        int n = 0;
+        bool anyStone = board.stones() > 0;
+        for (int cell = 0; cell < board.cells(); cell++) {
+            if (board.at(cell) != MNK_EMPTY) continue;
+            if (!fullWidth && anyStone && !board.near_stone(cell)) continue;
+            int value = cell == ttMove ? (1 << 30) : board.move_value(cell, player) + history[cell];
+            scored[n++] = { value, cell };
+        }
+        if (n == 0) return 0;
+        if (!anyStone && !fullWidth) {
+            moves[0] = board.index(board.rules().height / 2, board.rules().width / 2);
+            return 1;
+        }
+        // Ties by cell: the order a stable sort gives, without its heap buffer
+        std::sort(scored, scored + n, [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+            return a.first != b.first ? a.first > b.first : a.second < b.second;
+        });
+        if (!fullWidth && !root) n = std::min(n, MNK_BEAM);
+        for (int i = 0; i < n; i++) moves[i] = scored[i].second;
+        return n;
+    }
+
+    int negamax(MnkBoard& board, int player, int depth, int alpha, int beta, int ply) {
+        if ((++nodes & 1023) == 0 && out_of_budget()) aborted = true;
+        if (aborted) return 0;
+
+        int alphaStart = alpha;
+        std::uint64_t key = board.hash() ^ salt;
+        Entry& entry = table[key & mask];
+        int ttMove = -1;
+        if (entry.key == key) {
+            ttMove = entry.move;
+            if (entry.depth >= depth && ply > 0) {
+                int s = from_table(entry.score, ply);
+                if (entry.bound == EXACT) return s;
+                if (entry.bound == LOWER && s >= beta) return s;
+                if (entry.bound == UPPER && s <= alpha) return s;
+            }
+        }
+        if (depth == 0) return board.score(player);
+
+        int moves[MNK_MAX_CELLS];
+        int n = generate(board, player, ttMove, moves, ply == 0);
+        int best = -MNK_WIN, bestMove = moves[0];
+        for (int i = 0; i < n; i++) {
+            int m = moves[i];
+            board.play(m, player);
+            int s;
+            if (board.wins_at(m)) s = MNK_WIN - (ply + 1);
+            else if (board.full()) s = 0;
+            else s = -negamax(board, 3 - player, depth - 1, -beta, -alpha, ply + 1);
+            board.undo(m);
+            if (aborted) return 0;
+
+            if (s > best) {
+                best = s;
+                bestMove = m;
+                if (ply == 0) rootMove = m;
+            }
+            if (s > alpha) alpha = s;
+            if (alpha >= beta) {
+                history[m] += depth * depth;
+                break;
+            }
+        }
+
+        entry.key = key;
+        entry.score = to_table(best, ply);
+        entry.move = static_cast<std::int16_t>(bestMove);
+        entry.depth = static_cast<std::uint8_t>(std::min(depth, 255));
+        entry.bound = best <= alphaStart ? UPPER : best >= beta ? LOWER : EXACT;
+        return best;
+    }
+
+    std::vector<Entry> table;
+    std::size_t mask;
+    std::uint64_t generation = 0;
+    std::uint64_t salt = 0;
+    int history[MNK_MAX_CELLS] = {};    // Cutoff counts, for ordering quiet moves
+
+    Clock::time_point start, deadline;
+    bool useClock = true;
+    std::uint64_t nodeCap = 0;
+    const std::atomic<bool>* stopFlag = nullptr;
+    std::uint64_t nodes = 0;
+    bool aborted = false;
+    bool fullWidth = true;
+    int rootMove = -1;
+};
+
+// --- PONDERING ---
+
+// Keeps a search running on a worker thread while the opponent thinks. It guesses their
+// move from the table (the reply the last search expected) and searches the position
+// behind it; with no guess it searches their own options, which still leaves the table
+// full of positions the reply will visit. The search object is handed over for the
+// duration: touch it only after finish().
+class MnkPonder {
+public:
+    MnkPonder() = default;
+    MnkPonder(const MnkPonder&) = delete;
+    MnkPonder& operator=(const MnkPonder&) = delete;
+    ~MnkPonder() { halt(); }
+
+    void start(MnkSearch& search, const MnkBoard& board, int toMove) {
+        halt();     // The previous worker may still be writing the table the guess comes from
+        position = board;
+        guessed = search.table_move(board);
+        stopFlag.store(false);
+        worker = std::thread([this, &search, toMove] {
+            MnkLimits limits;
+            limits.milliseconds = 0;    // Until finish(), or until the position is solved
+            limits.stop = &stopFlag;
+            int player = toMove;
+            if (guessed >= 0) {
+                position.play(guessed, toMove);
+                player = 3 - toMove;
+            }
+            found = search.search(position, player, limits);
+        });
+    }
+
+    // Stops the worker. True, with what it found, when it was pondering `played`.
+    bool finish(int played, MnkSearchResult& result) {
+        bool hit = worker.joinable() && guessed >= 0 && played == guessed;
+        halt();
+        if (hit) result = found;
+        guessed = -1;
+        return hit;
+    }
+
+    // Stops the worker and drops what it found: the game ended before the reply.
+    void stop() {
+        halt();
+        guessed = -1;
+    }
+
+private:
+    void halt() {
+        if (!worker.joinable()) return;
+        stopFlag.store(true);
+        worker.join();
+    }
+
+    MnkBoard position;
+    int guessed = -1;
+    std::atomic<bool> stopFlag{false};
+    MnkSearchResult found;
+    std::thread worker;
+};
+
+#endif
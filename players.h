@@ -0,0 +1,453 @@
+/**
+ * ======================================================================================
+ * PLAYER STATS
+ * `--players FILE` keeps per-player totals (Tic-Tac-Toe vs CPU, Secret Number,
+ * Hangman, RPS) and a leaderboard across runs. Results update a flat in-memory table
+ * at once; a background thread appends them to FILE.log and fsyncs the whole group
+ * every PLAYER_COMMIT_MS, so a game never waits on the disk. When the log grows long
+ * the table is written out to FILE as a snapshot and the log starts over. The top
+ * PLAYER_TOP_N players are kept in order as scores change, so the leaderboard is a
+ * copy, not a sort.
+ * ======================================================================================
+ */
+
+#ifndef GAMEHUB_PLAYERS_H
+#define GAMEHUB_PLAYERS_H
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <io.h>
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+constexpr int PLAYER_NAME_MAX = 15;
+constexpr int PLAYER_TOP_N = 10;
+constexpr int PLAYER_COMMIT_MS = 200;               // Group commit interval
+constexpr std::uint64_t PLAYER_COMPACT_ENTRIES = 1 << 16;   // Log length that triggers a snapshot
+
+// Letters, digits, '-' and '_'; 1 to PLAYER_NAME_MAX of them.
+inline bool player_name_valid(std::string_view name) {
+    if (name.empty() || name.size() > static_cast<std::size_t>(PLAYER_NAME_MAX)) return false;
+    for (char c : name) {
+        bool ok = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' || c == '_';
+        if (!ok) return false;
+    }
+    return true;
+}
+
+// One player's totals; the table is an array of these, and so is the snapshot file.
+struct PlayerStats {
+    char name[PLAYER_NAME_MAX + 1];
+    std::uint32_t tttGames, tttWins, tttDraws;     // Against the CPU
+    std::uint32_t secretRounds, secretAttempts, secretBest;
+    std::uint32_t hangmanGames, hangmanSurvived;
+    std::uint32_t rpsRounds, rpsWins;
+    std::uint32_t score;
+    std::uint32_t reserved;
+};
+static_assert(sizeof(PlayerStats) == 64, "stats are written to disk as-is");
+
+// Only ever grows, which is what keeps the top-N index exact.
+inline std::uint32_t player_score(const PlayerStats& p) {
+    return 3 * p.tttWins + p.tttDraws + 2 * p.hangmanSurvived + p.secretRounds;
+}
+
+enum PlayerEvent : std::uint8_t { PLAYER_JOINED, PLAYER_TTT, PLAYER_SECRET, PLAYER_HANGMAN, PLAYER_RPS };
+enum PlayerTttResult : std::uint32_t { PLAYER_LOSS = 0, PLAYER_WIN = 1, PLAYER_DRAW = 2 };
+
+// One log entry. JOINED carries the name; the others two values:
+//   TTT      a = PlayerTttResult
+//   SECRET   a = attempts
+//   HANGMAN  a = 1 if survived
+//   RPS      a = rounds, b = rounds won
+struct PlayerLogEntry {
+    std::uint64_t seq;
+    std::uint32_t player;
+    std::uint8_t event;
+    std::uint8_t reserved[3];
+    union {
+        char name[PLAYER_NAME_MAX + 1];
+        std::uint32_t value[4];
+    };
+};
+static_assert(sizeof(PlayerLogEntry) == 32, "log entries are written to disk as-is");
+
+// Snapshot: this header, then `count` PlayerStats. Log: a header, then entries.
+struct PlayerFileHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t count;
+    std::uint32_t reserved;
+    std::uint64_t seq;      // Snapshot: the last entry it includes
+    std::uint64_t spare;
+};
+static_assert(sizeof(PlayerFileHeader) == 32, "");
+
+constexpr std::uint32_t PLAYER_FILE_VERSION = 1;
+
+// The top of the board, copied out under the lock.
+struct PlayerLeaderboard {
+    int count = 0;
+    PlayerStats rows[PLAYER_TOP_N];
+};
+
+class PlayerStore {
+public:
+    PlayerStore() = default;
+    PlayerStore(const PlayerStore&) = delete;
+    PlayerStore& operator=(const PlayerStore&) = delete;
+    ~PlayerStore() { close(); }
+
+    // Loads FILE and replays FILE.log over it, then starts the commit thread.
+    bool open(const std::string& path, std::string& error) {
+        snapshotPath = path;
+        logPath = path + ".log";
+        if (!load_snapshot(error) || !replay_log(error)) return false;
+        log = std::fopen(logPath.c_str(), "ab");
+        if (!log) {
+            error = "cannot open " + logPath + " for writing";
+            return false;
+        }
+        if (!hasLog && !write_log_header()) {
+            error = "cannot write " + logPath;
+            return false;
+        }
+        active = true;
+        committer = std::thread([this] { commit_loop(); });
+        return true;
+    }
+
+    bool is_open() const { return active; }
+
+    // Stops the commit thread after a last commit.
+    void close() {
+        if (!active) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        committer.join();
+        if (log) std::fclose(log);
+        log = nullptr;
+        active = false;
+    }
+
+    // The player's index, creating them on first sight.
+    int join(std::string_view name) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = byName.find(std::string(name));
+        if (found != byName.end()) return static_cast<int>(found->second);
+        PlayerLogEntry e = entry(static_cast<std::uint32_t>(table.size()), PLAYER_JOINED);
+        std::memcpy(e.name, name.data(), std::min(name.size(), static_cast<std::size_t>(PLAYER_NAME_MAX)));
+        apply(e);
+        pending.push_back(e);
+        return static_cast<int>(e.player);
+    }
+
+    // Counts a result in memory now; the commit thread makes it durable.
+    void record(int player, PlayerEvent event, std::uint32_t a, std::uint32_t b = 0) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (player < 0 || static_cast<std::size_t>(player) >= table.size()) return;
+        PlayerLogEntry e = entry(static_cast<std::uint32_t>(player), event);
+        e.value[0] = a;
+        e.value[1] = b;
+        apply(e);
+        pending.push_back(e);
+    }
+
+    PlayerStats stats(int player) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return player >= 0 && static_cast<std::size_t>(player) < table.size() ? table[player] : PlayerStats{};
+    }
+
+    PlayerLeaderboard leaderboard() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        PlayerLeaderboard board;
+        board.count = topCount;
+        for (int i = 0; i < topCount; i++) board.rows[i] = table[top[i]];
+        return board;
+    }
+
+    std::size_t players() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return table.size();
+    }
+
+private:
+    PlayerLogEntry entry(std::uint32_t player, PlayerEvent event) {
+        PlayerLogEntry e;
+        std::memset(&e, 0, sizeof e);
+        e.seq = ++lastSeq;
+        e.player = player;
+        e.event = event;
+        return e;
+    }
+
+    // The one place results change the table, live or replayed from the log.
+    void apply(const PlayerLogEntry& e) {
+        if (e.event == PLAYER_JOINED) {
+            if (e.player != table.size()) return;      // Out of step; ignore
+            PlayerStats p;
+            std::memset(&p, 0, sizeof p);
+            std::memcpy(p.name, e.name, PLAYER_NAME_MAX);
+            table.push_back(p);
+            byName.emplace(p.name, e.player);
+            return;
+        }
+        if (e.player >= table.size()) return;
+        PlayerStats& p = table[e.player];
+        switch (e.event) {
+            case PLAYER_TTT:
+                p.tttGames++;
+                if (e.value[0] == PLAYER_WIN) p.tttWins++;
+                else if (e.value[0] == PLAYER_DRAW) p.tttDraws++;
+                break;
+            case PLAYER_SECRET:
+                p.secretRounds++;
+                p.secretAttempts += e.value[0];
+                if (p.secretBest == 0 || e.value[0] < p.secretBest) p.secretBest = e.value[0];
+                break;
+            case PLAYER_HANGMAN:
+                p.hangmanGames++;
+                if (e.value[0]) p.hangmanSurvived++;
+                break;
+            case PLAYER_RPS:
+                p.rpsRounds += e.value[0];
+                p.rpsWins += e.value[1];
+                break;
+            default:
+                return;
+        }
+        std::uint32_t score = player_score(p);
+        if (score != p.score) {
+            p.score = score;
+            promote(e.player);
+        }
+    }
+
+    // Scores only rise, so a player can only move up: into the board past its last
+    // row, then past everyone now below them. Ties keep the earlier arrival first.
+    void promote(std::uint32_t player) {
+        int at = 0;
+        while (at < topCount && top[at] != player) at++;
+        if (at == topCount) {
+            if (topCount < PLAYER_TOP_N) topCount++;
+            else if (table[top[topCount - 1]].score >= table[player].score) return;
+            at = topCount - 1;
+            top[at] = player;
+        }
+        while (at > 0 && table[top[at - 1]].score < table[player].score) {
+            std::swap(top[at - 1], top[at]);
+            at--;
+        }
+    }
+
+    // --- FILES ---
+
+    bool load_snapshot(std::string& error) {
+        std::FILE* f = std::fopen(snapshotPath.c_str(), "rb");
+        if (!f) return true;    // First run
+        PlayerFileHeader h;
+        bool ok = std::fread(&h, sizeof h, 1, f) == 1 && std::memcmp(h.magic, "GHPS", 4) == 0 && h.version == PLAYER_FILE_VERSION;
+        for (std::uint32_t i = 0; ok && i < h.count; i++) {
+            PlayerLogEntry joined;
+            std::memset(&joined, 0, sizeof joined);
+            PlayerStats p;
+            ok = std::fread(&p, sizeof p, 1, f) == 1;
+            if (!ok) break;
+            p.name[PLAYER_NAME_MAX] = '\0';
+            joined.player = i;
+            std::memcpy(joined.name, p.name, PLAYER_NAME_MAX);
+            apply(joined);
+            table[i] = p;
+            promote(i);
+        }
+        std::fclose(f);
+        if (!ok) {
+            error = snapshotPath + " is not a player stats file";
+            return false;
+        }
+        lastSeq = snapshotSeq = h.seq;
+        return true;
+    }
+
+    bool replay_log(std::string& error) {
+        std::error_code ec;
+        std::uintmax_t size = std::filesystem::file_size(logPath, ec);
+        if (ec || size < sizeof(PlayerFileHeader)) {
+            // Missing, or the header never made it: start the log afresh
+            std::filesystem::remove(logPath, ec);
+            return true;
+        }
+        std::FILE* f = std::fopen(logPath.c_str(), "rb");
+        PlayerFileHeader h;
+        if (!f || std::fread(&h, sizeof h, 1, f) != 1 || std::memcmp(h.magic, "GHPL", 4) != 0 || h.version != PLAYER_FILE_VERSION) {
+            if (f) std::fclose(f);
+            error = logPath + " is not a player stats log";
+            return false;
+        }
+        // Entries the snapshot already holds are skipped
+        PlayerLogEntry e;
+        while (std::fread(&e, sizeof e, 1, f) == 1) {
+            logEntries++;
+            if (e.seq <= snapshotSeq) continue;
+            apply(e);
+            lastSeq = e.seq;
+        }
+        std::fclose(f);
+        // A commit cut short can leave a torn entry; drop it so appends stay aligned
+        std::uintmax_t whole = sizeof h + logEntries * sizeof(PlayerLogEntry);
+        if (whole != size) std::filesystem::resize_file(logPath, whole, ec);
+        hasLog = true;
+        return true;
+    }
+
+    bool write_log_header() {
+        PlayerFileHeader h = {};
+        std::memcpy(h.magic, "GHPL", 4);
+        h.version = PLAYER_FILE_VERSION;
+        return std::fwrite(&h, sizeof h, 1, log) == 1 && std::fflush(log) == 0;
+    }
+
+    static void sync(std::FILE* f) {
+#ifdef _WIN32
+        _commit(_fileno(f));
+#else
+        fsync(fileno(f));
+#endif
+    }
+
+    void log_lost() const {
+        std::fprintf(stderr, "Cannot write %s; player stats stay in memory until it can be started over\n", logPath.c_str());
+    }
+
+    // Every PLAYER_COMMIT_MS: whatever piled up goes out in one write and one fsync.
+    void commit_loop() {
+        std::vector<PlayerLogEntry> batch;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wake.wait_for(lock, std::chrono::milliseconds(PLAYER_COMMIT_MS), [this] { return stopping; });
+            bool last = stopping;
+            batch.swap(pending);
+            lock.unlock();
+
+            if (!batch.empty() && log) {
+                if (std::fwrite(batch.data(), sizeof(PlayerLogEntry), batch.size(), log) == batch.size() && std::fflush(log) == 0) {
+                    sync(log);
+                    logEntries += batch.size();
+                    batch.clear();
+                } else {
+                    // The log may now end partway through the batch; stop appending to
+                    // it, and let a snapshot cover the batch and start the log over
+                    std::fclose(log);
+                    log = nullptr;
+                    log_lost();
+                }
+            }
+            // The snapshot holds everything applied so far, an unwritten batch included
+            if ((logEntries >= PLAYER_COMPACT_ENTRIES || !log) && compact()) batch.clear();
+
+            lock.lock();
+            pending.insert(pending.begin(), batch.begin(), batch.end());
+            batch.clear();
+            if (last && (pending.empty() || !log)) return;
+        }
+    }
+
+    // Snapshot the table, then start the log over. Entries logged after the copy
+    // carry later sequence numbers, so a crash anywhere in here loses nothing: the
+    // old snapshot plus the old log, or the new snapshot plus whatever log survives.
+    // False if either file could not be written; a null log is retried every commit.
+    bool compact() {
+        std::vector<PlayerStats> copy;
+        std::uint64_t seq;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            copy = table;
+            seq = lastSeq;
+        }
+        std::string temp = snapshotPath + ".tmp";
+        std::FILE* f = std::fopen(temp.c_str(), "wb");
+        if (!f) return false;
+        PlayerFileHeader h = {};
+        std::memcpy(h.magic, "GHPS", 4);
+        h.version = PLAYER_FILE_VERSION;
+        h.count = static_cast<std::uint32_t>(copy.size());
+        h.seq = seq;
+        bool ok = std::fwrite(&h, sizeof h, 1, f) == 1 && std::fwrite(copy.data(), sizeof(PlayerStats), copy.size(), f) == copy.size();
+        ok = std::fflush(f) == 0 && ok;
+        if (ok) sync(f);
+        std::fclose(f);
+        if (!ok || !replace_file(temp, snapshotPath)) {
+            std::remove(temp.c_str());
+            return false;
+        }
+
+        // freopen closes the old stream even when it fails, so log is live or null
+        bool live = log != nullptr;
+        log = live ? std::freopen(logPath.c_str(), "wb", log) : std::fopen(logPath.c_str(), "wb");
+        if (!log || !write_log_header()) {
+            if (log) std::fclose(log);
+            log = nullptr;
+            if (live) log_lost();
+            return false;
+        }
+        sync(log);
+        logEntries = 0;
+        return true;
+    }
+
+    static bool replace_file(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+        return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+        return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+    }
+
+    mutable std::mutex mutex;               // Guards everything below except the files
+    std::vector<PlayerStats> table;
+    std::unordered_map<std::string, std::uint32_t> byName;
+    std::uint32_t top[PLAYER_TOP_N] = {};
+    int topCount = 0;
+    std::uint64_t lastSeq = 0;
+    std::vector<PlayerLogEntry> pending;    // Applied, not yet in the log
+    bool stopping = false;
+    std::condition_variable wake;
+
+    // Commit thread only (and open(), before it starts)
+    std::string snapshotPath, logPath;
+    std::FILE* log = nullptr;
+    std::uint64_t snapshotSeq = 0;
+    std::uint64_t logEntries = 0;
+    bool hasLog = false;                    // FILE.log existed, header and all
+    std::thread committer;
+    bool active = false;
+};
+
+inline PlayerStore& player_store() {
+    static PlayerStore store;
+    return store;
+}
+
+#endif
@@ -0,0 +1,334 @@
+/**
+ * ======================================================================================
+ * WORK POOL
+ * One set of worker threads for everything parallel: simulation chunks, the dice
+ * Monte Carlo, the Hangman sweep and, in server mode, every session's game code.
+ * Each worker owns a Chase-Lev deque: it pushes and pops its own end without locks,
+ * and idle workers steal from the other end of someone else's. Work meant for a
+ * particular worker (a session returning to the core whose caches hold its state)
+ * goes through that worker's lock-free inbox instead. No lock is taken on any path.
+ * ======================================================================================
+ */
+
+#ifndef GAMEHUB_POOL_H
+#define GAMEHUB_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Intrusive job: whoever submits it owns the storage and keeps it alive until `run`
+// has been called. `run` receives the job itself.
+struct PoolJob {
+    void (*run)(PoolJob*) = nullptr;
+    PoolJob* next = nullptr;    // Inbox link
+};
+
+// --- DEQUE ---
+
+// Chase-Lev work-stealing deque (the C11 formulation by Le, Pop, Cohen and Nardelli).
+// push/pop belong to the owning worker; steal may be called from any thread. The ring
+// doubles when full; old rings are kept until the deque dies, since a thief may still
+// be reading one.
+class WorkDeque {
+public:
+    WorkDeque() : ring(new Ring(INITIAL_CAPACITY)) { rings.emplace_back(ring.load(std::memory_order_relaxed)); }
+    WorkDeque(const WorkDeque&) = delete;
+    WorkDeque& operator=(const WorkDeque&) = delete;
+
+    void push(PoolJob* job) {
+        std::int64_t b = bottom.load(std::memory_order_relaxed);
+        std::int64_t t = top.load(std::memory_order_acquire);
+        Ring* r = ring.load(std::memory_order_relaxed);
+        if (b - t > r->mask) r = grow(r, t, b);
+        r->put(b, job);
+        bottom.store(b + 1, std::memory_order_release);     // Publishes the slot (and the job) to thieves
+    }
+
+    PoolJob* pop() {
+        std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Ring* r = ring.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = top.load(std::memory_order_relaxed);
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        PoolJob* job = r->get(b);
+        if (t == b) {
+            // Last job: race any thief for it
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) job = nullptr;
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    PoolJob* steal() {
+        std::int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b) return nullptr;
+        PoolJob* job = ring.load(std::memory_order_acquire)->get(t);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) return nullptr;
+        return job;
+    }
+
+    // Racy snapshot, for statistics.
+    std::int64_t size() const {
+        std::int64_t n = bottom.load(std::memory_order_relaxed) - top.load(std::memory_order_relaxed);
+        return n > 0 ? n : 0;
+    }
+
+private:
+    static constexpr std::int64_t INITIAL_CAPACITY = 256;
+
+    struct Ring {
+        std::int64_t mask;
+        std::unique_ptr<std::atomic<PoolJob*>[]> slots;
+        explicit Ring(std::int64_t capacity) : mask(capacity - 1), slots(new std::atomic<PoolJob*>[capacity]) {}
+        PoolJob* get(std::int64_t i) const { return slots[i & mask].load(std::memory_order_relaxed); }
+        void put(std::int64_t i, PoolJob* job) { slots[i & mask].store(job, std::memory_order_relaxed); }
+    };
+
+    Ring* grow(Ring* old, std::int64_t t, std::int64_t b) {
+        Ring* bigger = new Ring((old->mask + 1) * 2);
+        for (std::int64_t i = t; i < b; i++) bigger->put(i, old->get(i));
+        rings.emplace_back(bigger);
+        ring.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+    alignas(64) std::atomic<std::int64_t> top{0};
+    alignas(64) std::atomic<std::int64_t> bottom{0};
+    std::atomic<Ring*> ring;
+    std::vector<std::unique_ptr<Ring>> rings;   // Owner only
+};
+
+// --- POOL ---
+
+// Counters for sizing a deployment. `queued` is a snapshot; the rest are totals.
+struct PoolStats {
+    int workers = 0;
+    std::uint64_t executed = 0;     // Jobs run
+    std::uint64_t steals = 0;       // Jobs a worker took from another worker
+    std::int64_t queued = 0;        // Jobs waiting right now, all queues together
+    std::int64_t deepest = 0;       // Longest single worker queue right now
+};
+
+class WorkPool {
+public:
+    explicit WorkPool(int threads) : workers(static_cast<std::size_t>(std::max(threads, 1))) {
+        for (std::size_t i = 0; i < workers.size(); i++) {
+            workers[i].thread = std::thread([this, i] { work(static_cast<int>(i)); });
+        }
+    }
+    WorkPool(const WorkPool&) = delete;
+    WorkPool& operator=(const WorkPool&) = delete;
+    ~WorkPool() {
+        stopping.store(true);
+        for (Worker& w : workers) wake(w);
+        for (Worker& w : workers) w.thread.join();
+    }
+
+    int size() const { return static_cast<int>(workers.size()); }
+
+    // Queues `job`. With a worker index it goes to that worker's inbox and wakes it
+    // (others only take it while that worker is busy and they have nothing else to
+    // do); without one, the calling worker keeps it on its own deque for anyone to
+    // steal, and an outside thread spreads its jobs round robin.
+    void submit(PoolJob* job, int affinity = -1) {
+        Worker* self = current_worker();
+        if (affinity < 0 && self && self->pool == this) {
+            self->deque.push(job);
+            std::atomic_thread_fence(std::memory_order_seq_cst);   // Push visible before we look for sleepers
+            wake_idle(self);
+            return;
+        }
+        if (affinity < 0) affinity = static_cast<int>(nextInbox.fetch_add(1, std::memory_order_relaxed) % workers.size());
+        Worker& w = workers[static_cast<std::size_t>(affinity) % workers.size()];
+        PoolJob* head = w.inbox.load(std::memory_order_relaxed);
+        do job->next = head;
+        while (!w.inbox.compare_exchange_weak(head, job, std::memory_order_release, std::memory_order_relaxed));
+        w.inboxCount.fetch_add(1, std::memory_order_relaxed);
+        bool busy = w.busy.load();
+        wake(w);
+        if (busy) wake_idle(&w);    // Someone free may take it sooner
+    }
+
+    // Calls `fn(chunk, slot)` for every chunk in [0, chunks), on up to `participants`
+    // threads including the caller, and returns when all chunks are done. Chunks are
+    // claimed from one counter; slot says which participant (0 = the caller) ran it,
+    // so each can keep a private tally. Safe to call from inside a pool job: helpers
+    // that are still queued when the work runs out just find nothing to do.
+    template <class F>
+    void parallel_chunks(long long chunks, int participants, F& fn) {
+        if (chunks <= 0) return;
+        std::shared_ptr<ForkJoin> join = std::make_shared<ForkJoin>();
+        join->chunks = chunks;
+        join->context = &fn;
+        join->call = [](void* context, long long chunk, int slot) { (*static_cast<F*>(context))(chunk, slot); };
+        int helpers = static_cast<int>(std::min<long long>(std::max(participants, 1), chunks)) - 1;
+        for (int slot = 1; slot <= helpers; slot++) submit(new ForkJoinJob(join, slot));
+        join->work(0);
+        for (int n; (n = join->inFlight.load()) > 0; ) join->inFlight.wait(n);
+    }
+
+    PoolStats stats() const {
+        PoolStats s;
+        s.workers = size();
+        for (const Worker& w : workers) {
+            std::int64_t depth = w.deque.size() + w.inboxCount.load(std::memory_order_relaxed);
+            s.executed += w.executed.load(std::memory_order_relaxed);
+            s.steals += w.steals.load(std::memory_order_relaxed);
+            s.queued += depth;
+            s.deepest = std::max(s.deepest, depth);
+        }
+        return s;
+    }
+
+private:
+    struct alignas(64) Worker {
+        WorkPool* pool = nullptr;
+        WorkDeque deque;
+        std::atomic<PoolJob*> inbox{nullptr};       // Treiber stack; emptied whole
+        std::atomic<std::int64_t> inboxCount{0};
+        std::atomic<std::uint64_t> executed{0}, steals{0};
+        std::atomic<std::uint32_t> wakeups{0};      // Bumped to wake it; it sleeps on this
+        std::atomic<bool> asleep{false}, busy{false};
+        std::thread thread;
+    };
+
+    static void wake(Worker& w) {
+        w.wakeups.fetch_add(1);
+        if (w.asleep.load()) w.wakeups.notify_one();
+    }
+
+    // Wakes one sleeping worker other than `except`, if any is asleep.
+    void wake_idle(const Worker* except) {
+        for (Worker& w : workers) {
+            if (&w != except && w.asleep.load()) { wake(w); return; }
+        }
+    }
+
+    struct ForkJoin {
+        long long chunks = 0;
+        void* context = nullptr;
+        void (*call)(void*, long long, int) = nullptr;
+        std::atomic<long long> next{0};
+        std::atomic<int> inFlight{0};
+
+        // A participant counts itself in before its first claim, so once the caller
+        // has seen the counter run dry, waiting for inFlight covers every chunk taken.
+        void work(int slot) {
+            inFlight.fetch_add(1);
+            for (long long c; (c = next.fetch_add(1)) < chunks; ) call(context, c, slot);
+            if (inFlight.fetch_sub(1) == 1) inFlight.notify_all();
+        }
+    };
+
+    struct ForkJoinJob : PoolJob {
+        std::shared_ptr<ForkJoin> join;
+        int slot;
+        ForkJoinJob(std::shared_ptr<ForkJoin> join, int slot) : join(std::move(join)), slot(slot) {
+            run = [](PoolJob* job) {
+                ForkJoinJob* self = static_cast<ForkJoinJob*>(job);
+                self->join->work(self->slot);
+                delete self;
+            };
+        }
+    };
+
+    static Worker*& current_worker() {
+        thread_local Worker* worker = nullptr;
+        return worker;
+    }
+
+    // Moves a whole inbox onto `into`'s deque, oldest first; returns how many.
+    static std::int64_t drain(Worker& from, Worker& into) {
+        PoolJob* list = from.inbox.exchange(nullptr, std::memory_order_acquire);
+        if (!list) return 0;
+        PoolJob* fifo = nullptr;
+        std::int64_t n = 0;
+        while (list) {
+            PoolJob* next = list->next;
+            list->next = fifo;
+            fifo = list;
+            list = next;
+            n++;
+        }
+        from.inboxCount.fetch_sub(n, std::memory_order_relaxed);
+        while (fifo) {
+            PoolJob* next = fifo->next;     // Read first: once pushed, the job may run and requeue
+            into.deque.push(fifo);
+            fifo = next;
+        }
+        return n;
+    }
+
+    // Own deque, then own inbox, then other deques, then the inboxes of busy workers.
+    PoolJob* find(Worker& self, std::size_t index) {
+        if (PoolJob* job = self.deque.pop()) return job;
+        if (drain(self, self)) return self.deque.pop();
+        std::size_t n = workers.size();
+        for (std::size_t k = 1; k < n; k++) {
+            Worker& victim = workers[(index + k) % n];
+            if (PoolJob* job = victim.deque.steal()) { self.steals.fetch_add(1, std::memory_order_relaxed); return job; }
+        }
+        for (std::size_t k = 1; k < n; k++) {
+            Worker& victim = workers[(index + k) % n];
+            if (!victim.busy.load()) continue;
+            if (std::int64_t taken = drain(victim, self)) {
+                self.steals.fetch_add(static_cast<std::uint64_t>(taken), std::memory_order_relaxed);
+                return self.deque.pop();
+            }
+        }
+        return nullptr;
+    }
+
+    void work(int index) {
+        Worker& self = workers[static_cast<std::size_t>(index)];
+        self.pool = this;
+        current_worker() = &self;
+        while (!stopping.load(std::memory_order_relaxed)) {
+            PoolJob* job = find(self, static_cast<std::size_t>(index));
+            if (!job) {
+                // Announce the nap, look once more, then sleep until woken
+                std::uint32_t seen = self.wakeups.load();
+                self.asleep.store(true);
+                job = find(self, static_cast<std::size_t>(index));
+                if (!job && !stopping.load()) self.wakeups.wait(seen);
+                self.asleep.store(false);
+                if (!job) continue;
+            }
+            self.executed.fetch_add(1, std::memory_order_relaxed);
+            self.busy.store(true);
+            job->run(job);
+            self.busy.store(false);
+        }
+        current_worker() = nullptr;
+    }
+
+    std::vector<Worker> workers;
+    std::atomic<bool> stopping{false};
+    std::atomic<std::uint64_t> nextInbox{0};
+};
+
+// Worker count for the shared pool; set it (--threads) before the first work_pool().
+inline int& work_pool_threads() {
+    static int threads = 0;     // 0 = one per hardware thread
+    return threads;
+}
+
+inline WorkPool& work_pool() {
+    static WorkPool pool([] {
+        int threads = work_pool_threads() > 0 ? work_pool_threads() : static_cast<int>(std::thread::hardware_concurrency());
+        return threads > 0 ? threads : 1;
+    }());
+    return pool;
+}
+
+#endif
@@ -0,0 +1,302 @@
+/**
+ * ======================================================================================
+ * GAME RECORDS
+ * `--record FILE` appends every finished game (console, server or simulated) to a
+ * binary log of fixed 32-byte records: Tic-Tac-Toe as 4-bit cells, RPS as a pair of
+ * 2-bit moves per round, Hangman as 5-bit guesses plus the word's letter mask. Records
+ * are staged per thread and written in large batches, so logging keeps up with the
+ * simulator. Reading maps the file and indexes it in place: analysis over billions of
+ * games starts without a parse step (`--read-records FILE` prints a summary).
+ * ======================================================================================
+ */
+
+#ifndef GAMEHUB_RECORD_H
+#define GAMEHUB_RECORD_H
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "mapfile.h"
+
+enum RecordGame : std::uint8_t { RECORD_TTT = 1, RECORD_RPS = 2, RECORD_HANGMAN = 3 };
+enum RecordSource : std::uint8_t { RECORD_CONSOLE = 0, RECORD_SERVER = 1, RECORD_SIM = 2 };
+
+constexpr int RECORD_PAYLOAD_BITS = 192;
+constexpr int RECORD_TTT_BITS = 4;          // Cell index; boards of up to 16 cells
+constexpr int RECORD_RPS_BITS = 4;          // First side's move, then the second's
+constexpr int RECORD_HANGMAN_BITS = 5;      // Letter 0-25
+constexpr int RECORD_TTT_MAX_CELLS = 1 << RECORD_TTT_BITS;
+constexpr int RECORD_RPS_ROUNDS = RECORD_PAYLOAD_BITS / RECORD_RPS_BITS;
+constexpr std::uint8_t RECORD_HUMAN = 0xFF; // RPS side played by a person, not an RpsStrategy
+
+// One game (or, for RPS, up to RECORD_RPS_ROUNDS rounds of a match). Fields by game:
+//   TTT      outcome = winner (MnkStone: 0 draw, 1 X, 2 O); detail = width | height << 8 | k << 16
+//   RPS      outcome = rounds the first side won; detail = first side | second side << 8
+//   Hangman  outcome = misses; detail = the word's letters (bit i = 'A' + i) | length << 26
+struct GameRecord {
+    std::uint8_t game;
+    std::uint8_t source;
+    std::uint8_t outcome;
+    std::uint8_t count;             // Items packed below
+    std::uint32_t detail;
+    std::uint64_t packed[RECORD_PAYLOAD_BITS / 64];     // Item i at bits [i * width, (i + 1) * width)
+};
+static_assert(sizeof(GameRecord) == 32, "records are written to disk as-is");
+
+inline GameRecord record_start(RecordGame game, RecordSource source, std::uint32_t detail) {
+    GameRecord r = {};
+    r.game = game;
+    r.source = source;
+    r.detail = detail;
+    return r;
+}
+
+// Appends an item of `width` bits; false (and nothing stored) when the record is full.
+inline bool record_pack(GameRecord& r, int width, unsigned value) {
+    int bit = r.count * width;
+    if (bit + width > RECORD_PAYLOAD_BITS) return false;
+    int word = bit >> 6, shift = bit & 63;
+    r.packed[word] |= std::uint64_t(value) << shift;
+    if (shift + width > 64) r.packed[word + 1] |= std::uint64_t(value) >> (64 - shift);
+    r.count++;
+    return true;
+}
+
+inline unsigned record_item(const GameRecord& r, int width, int i) {
+    int bit = i * width;
+    int word = bit >> 6, shift = bit & 63;
+    std::uint64_t v = r.packed[word] >> shift;
+    if (shift + width > 64) v |= r.packed[word + 1] << (64 - shift);
+    return static_cast<unsigned>(v & ((1u << width) - 1));
+}
+
+// --- FILE FORMAT ---
+
+// The header is a record wide, so records stay 32-byte aligned in the mapping.
+struct RecordFileHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t recordSize;
+    std::uint8_t reserved[20];
+};
+static_assert(sizeof(RecordFileHeader) == sizeof(GameRecord), "the header keeps records aligned");
+
+constexpr std::uint32_t RECORD_VERSION = 1;
+
+inline RecordFileHeader record_header() {
+    RecordFileHeader h = {};
+    std::memcpy(h.magic, "GHRC", 4);
+    h.version = RECORD_VERSION;
+    h.recordSize = sizeof(GameRecord);
+    return h;
+}
+
+inline bool record_header_valid(const RecordFileHeader& h) {
+    return std::memcmp(h.magic, "GHRC", 4) == 0 && h.version == RECORD_VERSION && h.recordSize == sizeof(GameRecord);
+}
+
+// --- WRITER ---
+
+// Append-only. write() takes whole batches under one lock; callers normally go through
+// record_game(), which stages records per thread.
+class RecordLog {
+public:
+    RecordLog() = default;
+    RecordLog(const RecordLog&) = delete;
+    RecordLog& operator=(const RecordLog&) = delete;
+
+    // Opens (or creates) for appending. An existing file must be a record file.
+    bool open(const std::string& path, std::string& error) {
+        std::error_code ec;
+        std::uintmax_t size = std::filesystem::file_size(path, ec);
+        if (ec) size = 0;
+        if (size > 0) {
+            RecordFileHeader h;
+            std::ifstream in(path, std::ios::binary);
+            if (size < sizeof h || !in.read(reinterpret_cast<char*>(&h), sizeof h) || !record_header_valid(h)) {
+                error = "not a game record file";
+                return false;
+            }
+            // A batch cut short by a crash can leave a partial record; drop it so
+            // everything appended from here on stays aligned
+            std::uintmax_t whole = sizeof h + (size - sizeof h) / sizeof(GameRecord) * sizeof(GameRecord);
+            if (whole != size) std::filesystem::resize_file(path, whole, ec);
+        }
+
+        file.open(path, std::ios::binary | std::ios::app);
+        if (!file) {
+            error = "cannot open for writing";
+            return false;
+        }
+        if (size == 0) {
+            RecordFileHeader h = record_header();
+            file.write(reinterpret_cast<const char*>(&h), sizeof h);
+            file.flush();
+        }
+        active = true;
+        return true;
+    }
+
+    bool is_open() const { return active; }
+
+    void write(const GameRecord* records, std::size_t count) {
+        std::lock_guard<std::mutex> lock(mutex);
+        file.write(reinterpret_cast<const char*>(records), std::streamsize(count * sizeof(GameRecord)));
+        file.flush();
+        if (file) written += count;
+        else failed = true;
+    }
+
+    std::uint64_t records_written() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return written;
+    }
+
+    bool ok() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return !failed;
+    }
+
+private:
+    mutable std::mutex mutex;
+    std::ofstream file;
+    bool active = false;        // Set once, before any game runs
+    std::uint64_t written = 0;
+    bool failed = false;
+};
+
+inline RecordLog& record_log() {
+    static RecordLog log;
+    return log;
+}
+
+// Records waiting in this thread's batch. Reserved once, so staging never allocates.
+constexpr std::size_t RECORD_BATCH = 4096;
+
+inline std::vector<GameRecord>& record_batch() {
+    thread_local std::vector<GameRecord> batch;
+    return batch;
+}
+
+// Writes out this thread's batch. The simulator calls it after each chunk, the UI
+// after each game.
+inline void record_commit() {
+    std::vector<GameRecord>& batch = record_batch();
+    if (batch.empty()) return;
+    record_log().write(batch.data(), batch.size());
+    batch.clear();
+}
+
+// No-op unless --record is on.
+inline void record_game(const GameRecord& r) {
+    if (!record_log().is_open()) return;
+    std::vector<GameRecord>& batch = record_batch();
+    if (batch.capacity() == 0) batch.reserve(RECORD_BATCH);
+    batch.push_back(r);
+    if (batch.size() == RECORD_BATCH) record_commit();
+}
+
+// --- READER ---
+
+// The records of a mapped file, in place. A partial record at the end is ignored.
+class RecordFile {
+public:
+    bool open(const std::string& path, std::string& error) {
+        if (!file.open(path)) {
+            error = "cannot open";
+            return false;
+        }
+        RecordFileHeader h;
+        if (file.size() < sizeof h || (std::memcpy(&h, file.data(), sizeof h), !record_header_valid(h))) {
+            file.close();
+            error = "not a game record file";
+            return false;
+        }
+        records = reinterpret_cast<const GameRecord*>(file.data() + sizeof h);
+        count = (file.size() - sizeof h) / sizeof(GameRecord);
+        return true;
+    }
+
+    std::size_t size() const { return count; }
+    const GameRecord& operator[](std::size_t i) const { return records[i]; }
+    const GameRecord* begin() const { return records; }
+    const GameRecord* end() const { return records + count; }
+
+private:
+    MappedFile file;
+    const GameRecord* records = nullptr;
+    std::size_t count = 0;
+};
+
+// --- SUMMARY ---
+
+// Totals per game and source, straight off the mapping.
+inline int print_record_summary(const std::string& path, std::ostream& os) {
+    RecordFile records;
+    std::string error;
+    if (!records.open(path, error)) {
+        std::cerr << "Cannot read records from " << path << " (" << error << ")\n";
+        return 1;
+    }
+
+    struct Totals {
+        std::uint64_t tttGames = 0, tttMoves = 0, tttWins[3] = {};
+        std::uint64_t rpsRounds = 0, rpsFirstWins = 0;
+        std::uint64_t hangmanGames = 0, hangmanGuesses = 0, hangmanMisses = 0, hangmanSurvived = 0;
+        std::uint64_t other = 0;
+    } totals[3];
+
+    for (const GameRecord& r : records) {
+        Totals& t = totals[r.source < 3 ? r.source : int(RECORD_SIM)];
+        switch (r.game) {
+            case RECORD_TTT:
+                t.tttGames++;
+                t.tttMoves += r.count;
+                t.tttWins[r.outcome < 3 ? r.outcome : 0]++;
+                break;
+            case RECORD_RPS:
+                t.rpsRounds += r.count;
+                t.rpsFirstWins += r.outcome;
+                break;
+            case RECORD_HANGMAN:
+                t.hangmanGames++;
+                t.hangmanGuesses += r.count;
+                t.hangmanMisses += r.outcome;
+                if (r.outcome < 6) t.hangmanSurvived++;
+                break;
+            default:
+                t.other++;
+        }
+    }
+
+    static const char* const SOURCES[3] = { "console", "server", "simulation" };
+    os << records.size() << " records in " << path << "\n";
+    for (int s = 0; s < 3; s++) {
+        const Totals& t = totals[s];
+        if (t.tttGames + t.rpsRounds + t.hangmanGames + t.other == 0) continue;
+        os << "  " << SOURCES[s] << ":\n" << std::fixed << std::setprecision(2);
+        if (t.tttGames) {
+            os << "    Tic-Tac-Toe  " << t.tttGames << " games, " << double(t.tttMoves) / t.tttGames << " moves avg, X "
+               << t.tttWins[1] << " / O " << t.tttWins[2] << " / draw " << t.tttWins[0] << "\n";
+        }
+        if (t.rpsRounds) {
+            os << "    RPS          " << t.rpsRounds << " rounds, first side won " << 100.0 * t.rpsFirstWins / t.rpsRounds << "%\n";
+        }
+        if (t.hangmanGames) {
+            os << "    Hangman      " << t.hangmanGames << " games, " << double(t.hangmanGuesses) / t.hangmanGames << " guesses and "
+               << double(t.hangmanMisses) / t.hangmanGames << " misses avg, " << t.hangmanSurvived << " survived\n";
+        }
+        if (t.other) os << "    unknown      " << t.other << " records\n";
+        os << std::defaultfloat;
+    }
+    return 0;
+}
+
+#endif
@@ -0,0 +1,162 @@
+/**
+ * ======================================================================================
+ * RANDOM NUMBER ENGINE
+ * xoshiro256** generator with unbiased bounded draws, bulk fill and explicit seeding.
+ * Every thread (or session) owns its own instance, so there is no shared state to
+ * contend on and a fixed seed reproduces a run exactly.
+ * ======================================================================================
+ */
+
+#ifndef GAMEHUB_RNG_H
+#define GAMEHUB_RNG_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+// SplitMix64 step: expands one 64-bit seed into well-mixed generator state.
+inline std::uint64_t splitmix64(std::uint64_t& state) {
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+class Rng {
+public:
+    using result_type = std::uint64_t;
+
+    explicit Rng(std::uint64_t seed = 0) { reseed(seed); }
+
+    // Independent stream `stream` of a run seeded with `seed` (e.g. one per work chunk).
+    Rng(std::uint64_t seed, std::uint64_t stream) {
+        std::uint64_t mix = seed ^ (stream * 0xD1B54A32D192ED03ull);
+        reseed(splitmix64(mix));
+    }
+
+    void reseed(std::uint64_t seed) {
+        for (std::uint64_t& word : s) word = splitmix64(seed);
+    }
+
+    std::uint64_t next() {
+        std::uint64_t result = rotl(s[1] * 5, 7) * 9;
+        std::uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    std::uint32_t next32() { return static_cast<std::uint32_t>(next() >> 32); }
+
+    // Unbiased draw in [0, bound) using Lemire's multiply-and-reject; the modulo in
+    // the rejection threshold only runs on the rare slow path.
+    std::uint32_t below(std::uint32_t bound) {
+        std::uint64_t m = static_cast<std::uint64_t>(next32()) * bound;
+        std::uint32_t low = static_cast<std::uint32_t>(m);
+        if (low < bound) {
+            std::uint32_t threshold = (0u - bound) % bound;
+            while (low < threshold) {
+                m = static_cast<std::uint64_t>(next32()) * bound;
+                low = static_cast<std::uint32_t>(m);
+            }
+        }
+        return static_cast<std::uint32_t>(m >> 32);
+    }
+
+    // Unbiased draw in [min, max], inclusive.
+    int range(int min, int max) {
+        return min + static_cast<int>(below(static_cast<std::uint32_t>(max - min) + 1));
+    }
+
+    // Unbiased draw in [0, bound): the same method on a 64x64 -> 128-bit product.
+    std::uint64_t below64(std::uint64_t bound) {
+        std::uint64_t high, low;
+        mul128(next(), bound, high, low);
+        if (low < bound) {
+            std::uint64_t threshold = (0 - bound) % bound;
+            while (low < threshold) mul128(next(), bound, high, low);
+        }
+        return high;
+    }
+
+    // Unbiased draw in [min, max], inclusive; the whole 64-bit domain is allowed.
+    std::uint64_t range64(std::uint64_t min, std::uint64_t max) {
+        std::uint64_t span = max - min + 1;
+        return span == 0 ? next() : min + below64(span);
+    }
+
+    // Bulk fill with raw 64-bit outputs.
+    void fill(std::uint64_t* out, std::size_t count) {
+        for (std::size_t i = 0; i < count; i++) out[i] = next();
+    }
+
+    // Bulk fill with unbiased draws in [min, max].
+    template <class T>
+    void fill_range(T* out, std::size_t count, int min, int max) {
+        for (std::size_t i = 0; i < count; i++) out[i] = static_cast<T>(range(min, max));
+    }
+
+    // UniformRandomBitGenerator interface, so <random> distributions and std::shuffle work.
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~result_type(0); }
+    result_type operator()() { return next(); }
+
+private:
+    static std::uint64_t rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    static void mul128(std::uint64_t a, std::uint64_t b, std::uint64_t& high, std::uint64_t& low) {
+#ifdef __SIZEOF_INT128__
+        unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+        high = static_cast<std::uint64_t>(product >> 64);
+        low = static_cast<std::uint64_t>(product);
+#else
+        std::uint64_t aLow = a & 0xFFFFFFFFu, aHigh = a >> 32, bLow = b & 0xFFFFFFFFu, bHigh = b >> 32;
+        std::uint64_t ll = aLow * bLow, lh = aLow * bHigh, hl = aHigh * bLow, hh = aHigh * bHigh;
+        std::uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFFu) + (hl & 0xFFFFFFFFu);
+        high = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+        low = (mid << 32) | (ll & 0xFFFFFFFFu);
+#endif
+    }
+
+    std::uint64_t s[4];
+};
+
+// --- PROCESS SEED & PER-THREAD INSTANCES ---
+
+// Run-wide seed: set once from --seed before any worker starts, otherwise drawn from
+// the OS entropy source and the clock on first use.
+inline std::uint64_t& rng_seed_storage() {
+    static std::uint64_t seed = [] {
+        std::random_device rd;
+        std::uint64_t entropy = (static_cast<std::uint64_t>(rd()) << 32) ^ rd();
+        return entropy ^ static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    }();
+    return seed;
+}
+
+inline std::uint64_t rng_seed() { return rng_seed_storage(); }
+inline void rng_set_seed(std::uint64_t seed) { rng_seed_storage() = seed; }
+
+// A generator bound to this thread while it runs a network session's code, so each
+// session keeps its own sequence wherever it gets scheduled (null = the thread's own).
+inline Rng*& rng_binding() {
+    thread_local Rng* bound = nullptr;
+    return bound;
+}
+
+// The calling thread's generator. The first thread to ask (the UI thread) gets
+// stream 0 of the run seed, so `--seed` makes interactive sessions reproducible too.
+inline Rng& threadRng() {
+    static std::atomic<std::uint64_t> nextStream{0};
+    if (Rng* bound = rng_binding()) return *bound;
+    thread_local Rng rng(rng_seed(), nextStream.fetch_add(1, std::memory_order_relaxed));
+    return rng;
+}
+
+#endif
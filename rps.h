@@ -0,0 +1,146 @@
+/**
+ * ======================================================================================
+ * ROCK, PAPER, SCISSORS ENGINE
+ * Moves are 0 = Rock, 1 = Paper, 2 = Scissors. The CPU models its opponent with
+ * small context tables (no allocation, constant work per round) and plays whichever
+ * model has been reading them best lately.
+ * ======================================================================================
+ */
+
+#ifndef GAMEHUB_RPS_H
+#define GAMEHUB_RPS_H
+
+#include <cstdint>
+
+#include "rng.h"
+
+enum RpsOutcome { RPS_TIE = 0, RPS_WIN = 1, RPS_LOSS = 2 };
+
+// Outcome from the first player's point of view. Each move beats the one before it
+// (mod 3), so the difference of the two moves is the outcome directly.
+inline RpsOutcome rps_resolve(int pMove, int cMove) {
+    return static_cast<RpsOutcome>((pMove - cMove + 3) % 3);
+}
+
+inline int rps_random_move(Rng& rng) {
+    return static_cast<int>(rng.below(3));
+}
+
+// The move that beats `move`.
+inline int rps_counter(int move) {
+    return (move + 1) % 3;
+}
+
+// --- ADAPTIVE CPU ---
+
+enum RpsStrategy {
+    RPS_RANDOM,         // Uniform; unexploitable, and blind
+    RPS_CYCLE,          // Rock, Paper, Scissors, ...: a patterned human
+    RPS_FREQUENCY,      // Counters the opponent's most played move
+    RPS_MARKOV1,        // ... most played after the last round
+    RPS_MARKOV2,        // ... most played after the last two rounds
+    RPS_MIXTURE,        // Whichever of the above (or its second guess) is scoring best
+    RPS_STRATEGIES
+};
+
+inline const char* rps_strategy_name(int strategy) {
+    static const char* const NAMES[RPS_STRATEGIES] = { "Random", "Cycle", "Frequency", "Markov-1", "Markov-2", "Mixture" };
+    return NAMES[strategy];
+}
+
+// How often the opponent played each move after each context. A context's counts
+// halve when one reaches the cap, so old habits fade and nothing ever overflows.
+constexpr int RPS_COUNT_CAP = 1024;
+
+template <int CONTEXTS>
+struct RpsCounts {
+    std::uint16_t n[CONTEXTS][3] = {};
+
+    // Most frequent next move after `context`, or -1 with nothing seen yet.
+    int predict(int context) const {
+        const std::uint16_t* c = n[context];
+        if (c[0] + c[1] + c[2] == 0) return -1;
+        int best = c[1] > c[0] ? 1 : 0;
+        return c[2] > c[best] ? 2 : best;
+    }
+
+    void add(int context, int move) {
+        std::uint16_t* c = n[context];
+        if (++c[move] < RPS_COUNT_CAP) return;
+        c[0] >>= 1;
+        c[1] >>= 1;
+        c[2] >>= 1;
+    }
+};
+
+// One side of a match. choose() picks this round's move; observe() feeds back what
+// both sides played. Contexts are whole rounds (own move, opponent's move), so the
+// Markov tables also catch reactions such as "switch after losing".
+class RpsBrain {
+public:
+    explicit RpsBrain(RpsStrategy s = RPS_MIXTURE) : strategy(s) {}
+
+    int choose(Rng& rng) {
+        forecast_all();
+        int f = -1;
+        switch (strategy) {
+            case RPS_RANDOM: break;
+            case RPS_CYCLE: return rounds ? (lastMine + 1) % 3 : rps_random_move(rng);
+            case RPS_FREQUENCY: f = forecast[0]; break;
+            case RPS_MARKOV1: f = forecast[1]; break;
+            case RPS_MARKOV2: f = forecast[2]; break;
+            default: {
+                // Expert (p, r) expects the opponent to play predictor p's move shifted
+                // by r: r = 1 and 2 cover an opponent who is countering that very model.
+                int best = 0;
+                for (int p = 0; p < 3; p++) {
+                    if (forecast[p] < 0) continue;
+                    for (int r = 0; r < 3; r++) {
+                        if (score[p][r] > best) { best = score[p][r]; f = (forecast[p] + r) % 3; }
+                    }
+                }
+                break;
+            }
+        }
+        return f < 0 ? rps_random_move(rng) : rps_counter(f);
+    }
+
+    void observe(int mine, int theirs) {
+        forecast_all();
+        // Each expert's score is a decaying sum of the results it would have had
+        for (int p = 0; p < 3; p++) {
+            if (forecast[p] < 0) continue;
+            for (int r = 0; r < 3; r++) {
+                RpsOutcome o = rps_resolve(rps_counter((forecast[p] + r) % 3), theirs);
+                score[p][r] += (o == RPS_WIN ? RPS_SCORE_STEP : o == RPS_LOSS ? -RPS_SCORE_STEP : 0) - score[p][r] / 8;
+            }
+        }
+        frequency.add(0, theirs);
+        markov1.add(history % 9, theirs);
+        markov2.add(history, theirs);
+        history = (history * 9 + mine * 3 + theirs) % 81;
+        lastMine = mine;
+        rounds++;
+    }
+
+private:
+    static constexpr int RPS_SCORE_STEP = 64;
+
+    void forecast_all() {
+        forecast[0] = frequency.predict(0);
+        forecast[1] = markov1.predict(history % 9);
+        forecast[2] = markov2.predict(history);
+    }
+
+    RpsStrategy strategy;
+    RpsCounts<1> frequency;
+    RpsCounts<9> markov1;
+    RpsCounts<81> markov2;
+    int history = 0;            // Last two rounds, base 9
+    int lastMine = 0;
+    long long rounds = 0;
+    int forecast[3] = { -1, -1, -1 };
+    int score[3][3] = {};
+};
+
+#endif
@@ -0,0 +1,129 @@
+/**
+ * ======================================================================================
+ * SECRET NUMBER ENGINE
+ * Comparison oracle and the CPU solvers, over any range inside the unsigned 64-bit
+ * domain. Besides the honest oracle there are unreliable ones (answers flipped at
+ * random, or a bounded number of deliberate lies) and solvers built to survive them.
+ * ======================================================================================
+ */
+
+#ifndef GAMEHUB_SECRET_H
+#define GAMEHUB_SECRET_H
+
+#include <cstdint>
+
+#include "rng.h"
+
+enum SecretHint { SECRET_LOW, SECRET_HIGH, SECRET_HIT };
+
+inline SecretHint secret_compare(std::uint64_t guess, std::uint64_t secret) {
+    if (guess == secret) return SECRET_HIT;
+    return guess < secret ? SECRET_LOW : SECRET_HIGH;
+}
+
+inline std::uint64_t secret_pick(Rng& rng, std::uint64_t min, std::uint64_t max) {
+    return rng.range64(min, max);
+}
+
+// Midpoint without overflow, even for [0, 2^64 - 1].
+inline std::uint64_t secret_midpoint(std::uint64_t min, std::uint64_t max) {
+    return min + (max - min) / 2;
+}
+
+// Plays one round against the honest oracle with plain bisection; returns the attempts used.
+inline int secret_solve(std::uint64_t secret, std::uint64_t min, std::uint64_t max) {
+    int attempts = 0;
+    while (true) {
+        std::uint64_t guess = secret_midpoint(min, max);
+        attempts++;
+        SecretHint hint = secret_compare(guess, secret);
+        if (hint == SECRET_HIT) return attempts;
+        if (hint == SECRET_LOW) min = guess + 1;
+        else max = guess - 1;   // guess > secret >= min, so this never wraps
+    }
+}
+
+// --- UNRELIABLE ORACLES ---
+
+// A hit is always reported truthfully; a Low/High answer comes back reversed with
+// chance flipChance / 2^32, until `liesLeft` runs out (-1 = never).
+struct SecretOracle {
+    std::uint64_t secret = 0;
+    std::uint32_t flipChance = 0;
+    int liesLeft = -1;
+
+    SecretHint ask(Rng& rng, std::uint64_t guess) {
+        SecretHint truth = secret_compare(guess, secret);
+        if (truth == SECRET_HIT || liesLeft == 0 || flipChance == 0 || rng.next32() >= flipChance) return truth;
+        if (liesLeft > 0) liesLeft--;
+        return truth == SECRET_LOW ? SECRET_HIGH : SECRET_LOW;
+    }
+};
+
+inline std::uint32_t secret_chance(double p) {
+    return static_cast<std::uint32_t>(p * 4294967295.0);
+}
+
+enum SecretStrategy {
+    SECRET_BISECT,      // Trust every answer
+    SECRET_VOTE,        // Repeat a question until one answer leads by `margin`
+    SECRET_LIAR_SAFE,   // Repeat until one answer came `lies + 1` times: no lie can get through
+};
+
+struct SecretSolver {
+    SecretStrategy strategy = SECRET_BISECT;
+    int margin = 3;         // SECRET_VOTE
+    int lies = 0;           // SECRET_LIAR_SAFE: lies the oracle may tell in total
+};
+
+struct SecretResult {
+    int attempts = 0;       // Questions asked, repeats included
+    int restarts = 0;       // Times a contradiction sent the search back to the full range
+    bool found = false;
+};
+
+// Rounds that wander this long are abandoned (only a very noisy oracle gets here).
+constexpr int SECRET_MAX_ATTEMPTS = 1 << 16;
+
+// Bisection where each step asks until the solver's acceptance rule is met. A wrong
+// answer that slips through eventually leaves an empty interval; the search then
+// starts over on the full range instead of looping. `Oracle` is anything with
+// SecretOracle's ask(); the UI wraps one to print each question.
+template <class Oracle>
+SecretResult secret_solve(Oracle& oracle, Rng& rng, std::uint64_t min, std::uint64_t max, const SecretSolver& solver) {
+    SecretResult result;
+    std::uint64_t lo = min, hi = max;
+    while (result.attempts < SECRET_MAX_ATTEMPTS) {
+        std::uint64_t guess = secret_midpoint(lo, hi);
+        int low = 0, high = 0;
+        SecretHint hint;
+        while (true) {
+            hint = oracle.ask(rng, guess);
+            result.attempts++;
+            if (hint == SECRET_HIT) break;
+            (hint == SECRET_LOW ? low : high)++;
+            if (solver.strategy == SECRET_BISECT) break;
+            if (solver.strategy == SECRET_VOTE && (low - high >= solver.margin || high - low >= solver.margin)) break;
+            if (solver.strategy == SECRET_LIAR_SAFE && (low > solver.lies || high > solver.lies)) break;
+            if (result.attempts >= SECRET_MAX_ATTEMPTS) return result;
+        }
+        if (hint == SECRET_HIT) {
+            result.found = true;
+            return result;
+        }
+        bool goUp = low > high;
+        if (goUp ? guess == hi : guess == lo) {
+            // Nothing left on that side: some earlier answer was wrong
+            lo = min;
+            hi = max;
+            result.restarts++;
+        } else if (goUp) {
+            lo = guess + 1;
+        } else {
+            hi = guess - 1;
+        }
+    }
+    return result;
+}
+
+#endif
@@ -0,0 +1,597 @@
+/**
+ * ======================================================================================
+ * NETWORK SERVER
+ * Hosts many players from one process. Each TCP (or telnet) connection runs the game
+ * code as a coroutine (task.h): where the console would block on a keystroke or a
+ * pacing timer, the session suspends and the epoll/kqueue loop resumes it when that
+ * input or timer arrives. The loop thread only does I/O and timers; each stretch of
+ * game code runs as a job on the work pool (pool.h), normally on the session's home
+ * worker so its state stays in that core's caches. An idle session is just its
+ * suspended coroutine frames plus its buffers.
+ * POSIX only (epoll on Linux, kqueue on the BSDs and macOS).
+ * ======================================================================================
+ */
+
+#ifndef GAMEHUB_SERVER_H
+#define GAMEHUB_SERVER_H
+
+#if !defined(_WIN32)
+#define GAMEHUB_SERVER 1
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "pool.h"
+#include "task.h"
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#else
+#include <sys/event.h>
+#endif
+
+// --- POLLER ---
+
+struct PollEvent {
+    std::uint64_t token;
+    bool readable, writable;
+};
+
+// Readiness for many sockets: epoll on Linux, kqueue elsewhere. Sockets are always
+// watched for input; output interest is switched on only while a send is backed up.
+class Poller {
+public:
+    Poller() {
+#ifdef __linux__
+        fd = epoll_create1(EPOLL_CLOEXEC);
+#else
+        fd = kqueue();
+#endif
+    }
+    Poller(const Poller&) = delete;
+    Poller& operator=(const Poller&) = delete;
+    ~Poller() { if (fd >= 0) ::close(fd); }
+
+    bool ok() const { return fd >= 0; }
+
+    void add(int sock, std::uint64_t token) {
+#ifdef __linux__
+        epoll_event ev = {};
+        ev.events = EPOLLIN | EPOLLRDHUP;
+        ev.data.u64 = token;
+        epoll_ctl(fd, EPOLL_CTL_ADD, sock, &ev);
+#else
+        struct kevent ev[2];
+        EV_SET(&ev[0], sock, EVFILT_READ, EV_ADD, 0, 0, reinterpret_cast<void*>(token));
+        EV_SET(&ev[1], sock, EVFILT_WRITE, EV_ADD | EV_DISABLE, 0, 0, reinterpret_cast<void*>(token));
+        kevent(fd, ev, 2, nullptr, 0, nullptr);
+#endif
+    }
+
+    void want_write(int sock, std::uint64_t token, bool on) {
+#ifdef __linux__
+        epoll_event ev = {};
+        ev.events = EPOLLIN | EPOLLRDHUP | (on ? static_cast<std::uint32_t>(EPOLLOUT) : 0u);
+        ev.data.u64 = token;
+        epoll_ctl(fd, EPOLL_CTL_MOD, sock, &ev);
+#else
+        struct kevent ev;
+        EV_SET(&ev, sock, EVFILT_WRITE, on ? EV_ENABLE : EV_DISABLE, 0, 0, reinterpret_cast<void*>(token));
+        kevent(fd, &ev, 1, nullptr, 0, nullptr);
+#endif
+    }
+
+    // Closing a socket drops it from the set on both backends.
+
+    int wait(PollEvent* events, int max, int timeoutMs) {
+#ifdef __linux__
+        epoll_event raw[256];
+        int n = epoll_wait(fd, raw, std::min(max, 256), timeoutMs);
+        for (int i = 0; i < n; i++) {
+            events[i].token = raw[i].data.u64;
+            events[i].readable = raw[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR);
+            events[i].writable = raw[i].events & EPOLLOUT;
+        }
+        return n;
+#else
+        struct kevent raw[256];
+        timespec ts = { timeoutMs / 1000, (timeoutMs % 1000) * 1000000L };
+        int n = kevent(fd, nullptr, 0, raw, std::min(max, 256), timeoutMs < 0 ? nullptr : &ts);
+        for (int i = 0; i < n; i++) {
+            events[i].token = reinterpret_cast<std::uint64_t>(raw[i].udata);
+            events[i].readable = raw[i].filter == EVFILT_READ;
+            events[i].writable = raw[i].filter == EVFILT_WRITE;
+        }
+        return n;
+#endif
+    }
+
+private:
+    int fd = -1;
+};
+
+// --- CONNECTIONS ---
+
+class GameServer;
+
+// One player's socket, buffers and coroutine. The awaitables are used by the game code;
+// everything else belongs to the server loop, which leaves the buffers alone while
+// the session is out running on a worker.
+class ServerConnection {
+public:
+    ServerConnection(GameServer& server, int fd, std::uint64_t id) : server(server), sock(fd), ident(id) { job.conn = this; }
+
+    std::uint64_t id() const { return ident; }
+    const std::string& peer() const { return address; }
+
+    // Text bound for the player; sent whenever the session suspends.
+    std::string& outbox() { return out; }
+
+    // `co_await next_key()`: the next keystroke (0-255), or -1 once the player has gone.
+    // Escape sequences (arrows, function keys) are swallowed whole.
+    struct KeyAwaiter {
+        ServerConnection& c;
+        bool await_ready() { return c.key_waiting() || c.gone; }
+        void await_suspend(std::coroutine_handle<> h) { c.park(WAIT_INPUT, h); }
+        int await_resume() {
+            if (!c.key_waiting()) return -1;
+            return static_cast<unsigned char>(c.in[c.inPos++]);
+        }
+    };
+    KeyAwaiter next_key() { return { *this }; }
+
+    // `co_await wait_input(ms)`: suspends for up to `ms`. True as soon as input is
+    // waiting (or the player left), false when the time simply ran out.
+    struct WaitAwaiter {
+        ServerConnection& c;
+        int ms;
+        bool await_ready() { return ms <= 0 || c.key_waiting() || c.gone; }
+        void await_suspend(std::coroutine_handle<> h) {
+            c.timerMs = ms;     // The loop arms it once this run is over
+            c.park(WAIT_TIMER, h);
+        }
+        bool await_resume() { return c.key_waiting() || c.gone; }
+    };
+    WaitAwaiter wait_input(int ms) { return { *this, ms }; }
+
+    // True once the client has accepted both of our telnet offers (DO ECHO, DO SGA), so
+    // keys arrive one at a time and the echo is ours. Plain TCP clients such as nc never
+    // answer; they send whole lines and echo locally.
+    bool key_mode() const { return doEcho && doSga; }
+
+    void* user = nullptr;       // Session state owned by the session coroutine
+
+private:
+    friend class GameServer;
+    enum Wait { RUNNING, WAIT_INPUT, WAIT_TIMER };
+
+    // Skips complete escape sequences at the front, then reports whether a key is left.
+    bool key_waiting() {
+        while (inPos < in.size() && in[inPos] == '\x1b' && inPos + 1 < in.size() && (in[inPos + 1] == '[' || in[inPos + 1] == 'O')) {
+            std::size_t end = inPos + 2;
+            while (end < in.size() && !(in[end] >= 0x40 && in[end] <= 0x7E)) end++;
+            inPos = end < in.size() ? end + 1 : end;
+        }
+        return inPos < in.size();
+    }
+
+    void park(Wait why, std::coroutine_handle<> h) {
+        waiting = why;
+        resumePoint = h;
+    }
+
+    // Telnet: strips option negotiation (noting the client's answers to our offers),
+    // folds CR LF / CR NUL to a single CR, and treats an interrupt (Ctrl+C, in either
+    // form) as hanging up.
+    void decode(const unsigned char* p, std::size_t n) {
+        if (inPos == in.size()) { in.clear(); inPos = 0; }
+        for (std::size_t i = 0; i < n; i++) {
+            unsigned char b = p[i];
+            switch (telnet) {
+                case TN_CR:
+                    telnet = TN_DATA;
+                    if (b == '\n' || b == 0) break;
+                    [[fallthrough]];
+                case TN_DATA:
+                    if (b == 255) telnet = TN_IAC;
+                    else if (b == 3) gone = true;
+                    else {
+                        in.push_back(static_cast<char>(b));
+                        if (b == '\r') telnet = TN_CR;
+                    }
+                    break;
+                case TN_IAC:
+                    if (b == 255) { in.push_back(static_cast<char>(b)); telnet = TN_DATA; }
+                    else if (b >= 251) { verb = b; telnet = TN_OPTION; }   // WILL/WONT/DO/DONT x
+                    else if (b == 250) telnet = TN_SUB;
+                    else { if (b == 244) gone = true; telnet = TN_DATA; }
+                    break;
+                case TN_OPTION:
+                    if (verb == 253 || verb == 254) {       // DO / DONT
+                        if (b == 1) doEcho = verb == 253;
+                        else if (b == 3) doSga = verb == 253;
+                    }
+                    telnet = TN_DATA;
+                    break;
+                case TN_SUB: if (b == 255) telnet = TN_SUB_IAC; break;
+                case TN_SUB_IAC: telnet = b == 240 ? TN_DATA : TN_SUB; break;
+            }
+        }
+    }
+
+    struct StepJob : PoolJob {
+        ServerConnection* conn = nullptr;
+    };
+
+    GameServer& server;
+    int sock;
+    std::uint64_t ident;
+    std::string address;
+    Task<void> session;
+    std::coroutine_handle<> resumePoint;    // Where the session continues once woken
+    Wait waiting = RUNNING;
+    bool gone = false;              // Peer closed, errored or hung up
+    bool writeArmed = false;
+    std::uint64_t timerSeq = 0;     // Bumped per wait, so stale timer entries are ignored
+    int timerMs = 0;
+    std::string in, out;
+    std::size_t inPos = 0;
+
+    // Loop side: set while a worker runs the session; input meanwhile waits in `raw`
+    StepJob job;
+    int home = -1;                  // Preferred worker
+    bool running = false;
+    bool rawClosed = false;
+    std::string raw;
+    ServerConnection* nextDone = nullptr;
+    enum { TN_DATA, TN_CR, TN_IAC, TN_OPTION, TN_SUB, TN_SUB_IAC } telnet = TN_DATA;
+    unsigned char verb = 0;         // Command byte of the option being read
+    bool doEcho = false, doSga = false;
+};
+
+// --- SERVER LOOP ---
+
+// `session` is started for each new connection and runs until the player leaves.
+// `enter` and `leave` bracket every stretch it runs, for binding per-session globals.
+// `report` fills in the text served on the stats port.
+struct ServerHooks {
+    Task<void> (*session)(ServerConnection&) = nullptr;
+    void (*enter)(ServerConnection&) = nullptr;
+    void (*leave)(ServerConnection&) = nullptr;
+    void (*report)(std::string& text) = nullptr;
+};
+
+// A client that stops reading is dropped once this much output is queued for it.
+constexpr std::size_t SERVER_MAX_BACKLOG = 1 << 20;
+
+// How often a busy server logs its session count and pool counters to stderr.
+constexpr int SERVER_STATS_SECONDS = 60;
+
+class GameServer {
+public:
+    explicit GameServer(ServerHooks hooks) : hooks(hooks) {}
+    GameServer(const GameServer&) = delete;
+    GameServer& operator=(const GameServer&) = delete;
+    ~GameServer() {
+        if (wakeRead >= 0) ::close(wakeRead);
+        if (wakeWrite >= 0) ::close(wakeWrite);
+    }
+
+    // Serves until the listening socket fails; returns the process exit code. With a
+    // stats port, every connection to it gets one report and is closed.
+    int run(int port, int statsPort = 0) {
+        std::signal(SIGPIPE, SIG_IGN);
+        if (!poller.ok()) { std::perror("poller"); return 1; }
+        int wake[2];
+        if (pipe(wake) != 0) { std::perror("pipe"); return 1; }
+        wakeRead = wake[0];
+        wakeWrite = wake[1];
+        set_nonblocking(wakeRead);
+        set_nonblocking(wakeWrite);
+        poller.add(wakeRead, WAKEUP);
+
+        if ((listener = open_listener(port)) < 0) return 1;
+        poller.add(listener, LISTENER);
+        if (statsPort > 0) {
+            if ((statsListener = open_listener(statsPort)) < 0) return 1;
+            poller.add(statsListener, STATS_LISTENER);
+            std::fprintf(stderr, "Stats on port %d\n", statsPort);
+        }
+        std::fprintf(stderr, "Game hub listening on port %d (telnet or any TCP client), %d worker thread(s)\n", port, work_pool().size());
+        nextStats = Clock::now() + std::chrono::seconds(SERVER_STATS_SECONDS);
+
+        PollEvent events[256];
+        while (true) {
+            int n = poller.wait(events, 256, next_timeout());
+            if (n < 0 && errno != EINTR) { std::perror("poll"); return 1; }
+            for (int i = 0; i < n; i++) {
+                if (events[i].token == LISTENER) { accept_all(); continue; }
+                if (events[i].token == STATS_LISTENER) { serve_stats(); continue; }
+                if (events[i].token == WAKEUP) { collect_finished(); continue; }
+                auto it = connections.find(events[i].token);
+                if (it == connections.end()) continue;
+                ServerConnection& c = *it->second;
+                if (events[i].writable && !c.running) flush(c);
+                if (events[i].readable) receive(c);
+                settle(c);
+            }
+            fire_timers();
+            log_stats();
+        }
+    }
+
+    std::size_t sessions() const { return connections.size(); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    static constexpr std::uint64_t LISTENER = 0;
+    static constexpr std::uint64_t WAKEUP = ~std::uint64_t(0);
+    static constexpr std::uint64_t STATS_LISTENER = ~std::uint64_t(0) - 1;
+
+    struct Timer {
+        Clock::time_point at;
+        std::uint64_t id, seq;
+        bool operator>(const Timer& o) const { return at > o.at; }
+    };
+
+    static void set_nonblocking(int fd) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+
+    // Dual-stack where the system has IPv6; -1 (after reporting why) on failure.
+    static int open_listener(int port) {
+        int fd = socket(AF_INET6, SOCK_STREAM, 0);
+        bool v6 = fd >= 0;
+        if (!v6) fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) { std::perror("socket"); return -1; }
+        int one = 1, zero = 0;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        int bound;
+        if (v6) {
+            setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &zero, sizeof(zero));  // Take IPv4 too
+            sockaddr_in6 addr = {};
+            addr.sin6_family = AF_INET6;
+            addr.sin6_addr = in6addr_any;
+            addr.sin6_port = htons(static_cast<std::uint16_t>(port));
+            bound = bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        } else {
+            sockaddr_in addr = {};
+            addr.sin_family = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_ANY);
+            addr.sin_port = htons(static_cast<std::uint16_t>(port));
+            bound = bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        }
+        if (bound != 0 || listen(fd, SOMAXCONN) != 0) { std::perror("bind/listen"); ::close(fd); return -1; }
+        set_nonblocking(fd);
+        return fd;
+    }
+
+    // The report is a few KB, well inside a fresh socket's send buffer, so one
+    // non-blocking write normally takes it all; a client that can't keep up gets less.
+    void serve_stats() {
+        while (true) {
+            int fd = accept(statsListener, nullptr, nullptr);
+            if (fd < 0) return;
+            set_nonblocking(fd);
+            PoolStats pool = work_pool().stats();
+            char line[160];
+            std::snprintf(line, sizeof(line), "[STATS] sessions %zu  workers %d  queued %lld  runs %llu  steals %llu\n",
+                          connections.size(), pool.workers, static_cast<long long>(pool.queued),
+                          static_cast<unsigned long long>(pool.executed), static_cast<unsigned long long>(pool.steals));
+            std::string text = line;
+            if (hooks.report) hooks.report(text);
+            ssize_t ignored = ::write(fd, text.data(), text.size());
+            (void)ignored;
+            ::close(fd);
+        }
+    }
+
+    void accept_all() {
+        while (true) {
+            sockaddr_storage addr;
+            socklen_t len = sizeof(addr);
+            int fd = accept(listener, reinterpret_cast<sockaddr*>(&addr), &len);
+            if (fd < 0) return;     // EAGAIN, or out of descriptors until someone leaves
+            set_nonblocking(fd);
+            int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+            std::uint64_t id = ++lastId;
+            std::unique_ptr<ServerConnection> c(new ServerConnection(*this, fd, id));
+            char host[INET6_ADDRSTRLEN] = "?";
+            if (addr.ss_family == AF_INET6) inet_ntop(AF_INET6, &reinterpret_cast<sockaddr_in6*>(&addr)->sin6_addr, host, sizeof(host));
+            else if (addr.ss_family == AF_INET) inet_ntop(AF_INET, &reinterpret_cast<sockaddr_in*>(&addr)->sin_addr, host, sizeof(host));
+            c->address = host;
+            c->home = static_cast<int>(id % static_cast<std::uint64_t>(work_pool().size()));
+
+            // Ask telnet clients for character mode: we echo, and keys arrive one at a time
+            static const unsigned char NEGOTIATE[] = { 255, 251, 1, 255, 251, 3 };
+            c->out.append(reinterpret_cast<const char*>(NEGOTIATE), sizeof(NEGOTIATE));
+
+            ServerConnection& ref = *c;
+            connections.emplace(id, std::move(c));
+            poller.add(fd, id);
+            ref.session = hooks.session(ref);
+            schedule(ref);
+        }
+    }
+
+    // Hands the session to its home worker; the buffers are the worker's until the
+    // run comes back through collect_finished().
+    void schedule(ServerConnection& c) {
+        c.running = true;
+        c.job.run = &GameServer::run_step;
+        work_pool().submit(&c.job, c.home);
+    }
+
+    // On a worker: runs the session until it suspends for input or a timer (or ends).
+    // The first run starts it.
+    static void run_step(PoolJob* job) {
+        ServerConnection& c = *static_cast<ServerConnection::StepJob*>(job)->conn;
+        GameServer& server = c.server;
+        std::coroutine_handle<> next = std::exchange(c.resumePoint, std::coroutine_handle<>());
+        c.waiting = ServerConnection::RUNNING;
+        if (server.hooks.enter) server.hooks.enter(c);
+        if (next) next.resume();
+        else c.session.start();
+        if (server.hooks.leave) server.hooks.leave(c);
+
+        // Back to the loop: push onto the finished list, and wake it if it was empty
+        ServerConnection* head = server.finished.load(std::memory_order_relaxed);
+        do c.nextDone = head;
+        while (!server.finished.compare_exchange_weak(head, &c, std::memory_order_release, std::memory_order_relaxed));
+        if (!head) {
+            char byte = 1;
+            ssize_t ignored = ::write(server.wakeWrite, &byte, 1);
+            (void)ignored;
+        }
+    }
+
+    void collect_finished() {
+        char drain[64];
+        while (::read(wakeRead, drain, sizeof(drain)) > 0) {}
+        ServerConnection* c = finished.exchange(nullptr, std::memory_order_acquire);
+        while (c) {
+            ServerConnection* next = c->nextDone;
+            c->running = false;
+            if (!c->raw.empty()) {
+                c->decode(reinterpret_cast<const unsigned char*>(c->raw.data()), c->raw.size());
+                c->raw.clear();
+            }
+            if (c->rawClosed) c->gone = true;
+            if (c->waiting == ServerConnection::WAIT_TIMER) add_timer(*c, c->timerMs);
+            flush(*c);
+            settle(*c);
+            c = next;
+        }
+    }
+
+    // Next move for an idle session: run it if what it waits for is there (a player
+    // who left is also resumed, so the game code can unwind), close it once it ended.
+    void settle(ServerConnection& c) {
+        if (c.running) return;
+        if (c.session.done()) {
+            if (!c.out.empty() && !c.gone) flush(c);
+            ::close(c.sock);
+            connections.erase(c.ident);
+            return;
+        }
+        if (c.waiting != ServerConnection::RUNNING && (c.key_waiting() || c.gone)) schedule(c);
+    }
+
+    void receive(ServerConnection& c) {
+        unsigned char buf[4096];
+        bool closed = false;
+        while (true) {
+            ssize_t n = ::read(c.sock, buf, sizeof(buf));
+            if (n > 0) {
+                if (c.running) c.raw.append(reinterpret_cast<const char*>(buf), static_cast<std::size_t>(n));
+                else c.decode(buf, static_cast<std::size_t>(n));
+                continue;
+            }
+            if (n < 0 && errno == EINTR) continue;
+            if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) closed = true;
+            break;
+        }
+        if (!closed) return;
+        if (c.running) c.rawClosed = true;
+        else c.gone = true;
+    }
+
+    void flush(ServerConnection& c) {
+        std::string& out = c.out;
+        std::size_t sentBytes = 0;
+        while (sentBytes < out.size()) {
+            ssize_t n = ::write(c.sock, out.data() + sentBytes, out.size() - sentBytes);
+            if (n > 0) { sentBytes += static_cast<std::size_t>(n); continue; }
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+            c.gone = true;
+            out.clear();
+            return;
+        }
+        out.erase(0, sentBytes);
+        if (out.size() > SERVER_MAX_BACKLOG) { c.gone = true; out.clear(); }
+        bool arm = !out.empty();
+        if (arm != c.writeArmed) {
+            poller.want_write(c.sock, c.ident, arm);
+            c.writeArmed = arm;
+        }
+    }
+
+    int next_timeout() {
+        Clock::time_point due = nextStats;
+        if (!timers.empty()) due = std::min(due, timers.front().at);
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(due - Clock::now()).count();
+        return left <= 0 ? 0 : static_cast<int>(left + 1);
+    }
+
+    void add_timer(ServerConnection& c, int ms) {
+        timers.push_back({ Clock::now() + std::chrono::milliseconds(ms), c.ident, ++c.timerSeq });
+        std::push_heap(timers.begin(), timers.end(), std::greater<Timer>());
+    }
+
+    void fire_timers() {
+        auto now = Clock::now();
+        while (!timers.empty() && timers.front().at <= now) {
+            Timer t = timers.front();
+            std::pop_heap(timers.begin(), timers.end(), std::greater<Timer>());
+            timers.pop_back();
+            auto it = connections.find(t.id);
+            if (it == connections.end()) continue;
+            ServerConnection& c = *it->second;
+            if (c.running || c.waiting != ServerConnection::WAIT_TIMER || c.timerSeq != t.seq) continue;
+            schedule(c);
+        }
+    }
+
+    // One line per interval, and only when something changed since the last one.
+    void log_stats() {
+        auto now = Clock::now();
+        if (now < nextStats) return;
+        nextStats = now + std::chrono::seconds(SERVER_STATS_SECONDS);
+        PoolStats pool = work_pool().stats();
+        if (pool.executed == loggedJobs && connections.size() == loggedSessions) return;
+        loggedJobs = pool.executed;
+        loggedSessions = connections.size();
+        std::fprintf(stderr, "sessions %zu  workers %d  queued %lld (deepest %lld)  runs %llu  steals %llu\n",
+                     connections.size(), pool.workers, static_cast<long long>(pool.queued), static_cast<long long>(pool.deepest),
+                     static_cast<unsigned long long>(pool.executed), static_cast<unsigned long long>(pool.steals));
+    }
+
+    ServerHooks hooks;
+    Poller poller;
+    int listener = -1;
+    int statsListener = -1;
+    int wakeRead = -1, wakeWrite = -1;          // Self-pipe: workers nudge the loop
+    std::atomic<ServerConnection*> finished{nullptr};   // Runs handed back by workers
+    std::uint64_t lastId = 0;
+    std::unordered_map<std::uint64_t, std::unique_ptr<ServerConnection>> connections;
+    std::vector<Timer> timers;      // Min-heap on deadline; entries for finished waits go stale
+    Clock::time_point nextStats;
+    std::uint64_t loggedJobs = 0;
+    std::size_t loggedSessions = 0;
+};
+
+#endif
+#endif
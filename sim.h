@@ -0,0 +1,443 @@
+/**
+ * ======================================================================================
+ * HEADLESS SIMULATION MODE
+ * Runs CPU-vs-CPU games with no UI, spread across all cores, and reports throughput
+ * and outcome distributions. Used to load-test AI changes and regression-check win
+ * rates: `gamehub --simulate [ttt|rps|dice|secret|hangman|all] [--games N]
+ * [--threads T] [--seed S]`. A given seed reproduces the same totals for any thread count.
+ * ======================================================================================
+ */
+
+#ifndef GAMEHUB_SIM_H
+#define GAMEHUB_SIM_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dice.h"
+#include "hangman.h"
+#include "metrics.h"
+#include "pool.h"
+#include "record.h"
+#include "rng.h"
+#include "rps.h"
+#include "secret.h"
+#include "ttt.h"
+
+struct SimConfig {
+    std::string game = "all";
+    long long games = 1000000;
+    int threads = 0;            // 0 = one worker per hardware thread
+    std::uint64_t seed = 0;     // Filled from rng_seed() when the run starts
+};
+
+// --- PER-GAME TALLIES ---
+// Each worker fills its own copy; the copies are merged once at the end.
+
+struct TttSimStats {
+    long long games = 0, xWins = 0, oWins = 0, draws = 0;
+    void merge(const TttSimStats& o) { games += o.games; xWins += o.xWins; oWins += o.oWins; draws += o.draws; }
+};
+
+struct RpsSimStats {
+    long long rounds = 0, wins = 0, losses = 0, ties = 0;
+    void merge(const RpsSimStats& o) { rounds += o.rounds; wins += o.wins; losses += o.losses; ties += o.ties; }
+};
+
+struct SecretSimStats {
+    long long rounds = 0, attempts = 0, restarts = 0, failed = 0;
+    long long histogram[8] = {};    // Bisection over 1-100 never needs more than 7 guesses
+    void merge(const SecretSimStats& o) {
+        rounds += o.rounds; attempts += o.attempts; restarts += o.restarts; failed += o.failed;
+        for (int i = 0; i < 8; i++) histogram[i] += o.histogram[i];
+    }
+};
+
+struct HangmanSimStats {
+    long long games = 0, solved = 0, guesses = 0, misses = 0;
+    long long histogram[27] = {};   // Misses needed to finish the word
+    void merge(const HangmanSimStats& o) {
+        games += o.games; solved += o.solved; guesses += o.guesses; misses += o.misses;
+        for (int i = 0; i < 27; i++) histogram[i] += o.histogram[i];
+    }
+};
+
+// --- GAME KERNELS ---
+
+// Random 'X' against the perfect tablebase 'O'. Any X win is an AI regression.
+inline void sim_ttt_game(Rng& rng, TttSimStats& stats) {
+    TttBoard board;
+    GameRecord record = record_start(RECORD_TTT, RECORD_SIM, 3 | 3 << 8 | 3 << 16);
+    char winner = 'C';
+    while (true) {
+        int cell = random_move(board, rng);
+        place_marker(board, cell + 1, 'X');
+        record_pack(record, RECORD_TTT_BITS, cell);
+        if ((winner = check_winner(board)) != 'C') break;
+        int reply = best_move(board);
+        place_marker(board, reply + 1, 'O');
+        record_pack(record, RECORD_TTT_BITS, reply);
+        if ((winner = check_winner(board)) != 'C') break;
+    }
+    stats.games++;
+    if (winner == 'X') stats.xWins++;
+    else if (winner == 'O') stats.oWins++;
+    else stats.draws++;
+    record.outcome = winner == 'X' ? 1 : winner == 'O' ? 2 : 0;
+    record_game(record);
+}
+
+// `count` rounds between two fresh brains; outcomes from `first`'s side. Recorded
+// RECORD_RPS_ROUNDS rounds to a record.
+inline void sim_rps_match(Rng& rng, long long count, RpsStrategy first, RpsStrategy second, RpsSimStats& stats) {
+    RpsBrain a(first), b(second);
+    const std::uint32_t sides = static_cast<std::uint32_t>(first) | static_cast<std::uint32_t>(second) << 8;
+    GameRecord record = record_start(RECORD_RPS, RECORD_SIM, sides);
+    for (long long i = 0; i < count; i++) {
+        int ma = a.choose(rng), mb = b.choose(rng);
+        a.observe(ma, mb);
+        b.observe(mb, ma);
+        RpsOutcome outcome = rps_resolve(ma, mb);
+        stats.rounds++;
+        if (outcome == RPS_WIN) stats.wins++;
+        else if (outcome == RPS_LOSS) stats.losses++;
+        else stats.ties++;
+
+        if (record.count == RECORD_RPS_ROUNDS) {
+            record_game(record);
+            record = record_start(RECORD_RPS, RECORD_SIM, sides);
+        }
+        record_pack(record, RECORD_RPS_BITS, static_cast<unsigned>(ma | mb << 2));
+        if (outcome == RPS_WIN) record.outcome++;
+    }
+    if (record.count) record_game(record);
+}
+
+inline void sim_secret_round(Rng& rng, SecretSimStats& stats) {
+    int attempts = secret_solve(secret_pick(rng, 1, 100), 1, 100);
+    stats.rounds++;
+    stats.attempts += attempts;
+    stats.histogram[attempts]++;
+}
+
+// One benchmark setting for the general solver: a range, an oracle and a strategy.
+struct SecretScenario {
+    const char* title;
+    std::uint64_t min, max;
+    double noise;           // Chance of a flipped answer
+    int lies;               // Cap on flipped answers (-1 = none)
+    SecretSolver solver;
+};
+
+inline void sim_secret_scenario_round(Rng& rng, const SecretScenario& scenario, SecretSimStats& stats) {
+    SecretOracle oracle;
+    oracle.secret = secret_pick(rng, scenario.min, scenario.max);
+    oracle.flipChance = secret_chance(scenario.noise);
+    oracle.liesLeft = scenario.lies;
+    SecretResult r = secret_solve(oracle, rng, scenario.min, scenario.max, scenario.solver);
+    stats.rounds++;
+    stats.attempts += r.attempts;
+    stats.restarts += r.restarts;
+    if (!r.found) stats.failed++;
+}
+
+// The solver against one dictionary word, played to the end so the miss count is
+// known even past the six lives a player has.
+inline void sim_hangman_game(HangmanSolver& solver, const HangmanSolverIndex& index, std::string_view word, HangmanSimStats& stats) {
+    HangmanGame game;
+    game.word = hangman_word(word);
+    solver.reset(index, game.word.length);
+    GameRecord record = record_start(RECORD_HANGMAN, RECORD_SIM, game.word.letters | static_cast<std::uint32_t>(game.word.length) << 26);
+    int guesses = 0, misses = 0;
+    while (!hangman_solved(game)) {
+        int letter = solver.next_guess();
+        if (hangman_guess(game, letter) == HANGMAN_MISS) misses++;
+        guesses++;
+        record_pack(record, RECORD_HANGMAN_BITS, static_cast<unsigned>(letter));
+        solver.observe(letter, game.word.positions[letter]);
+    }
+    record.outcome = static_cast<std::uint8_t>(misses);
+    record_game(record);
+    stats.games++;
+    stats.guesses += guesses;
+    stats.misses += misses;
+    if (misses < 6) stats.solved++;
+    stats.histogram[misses]++;
+}
+
+// --- PARALLEL DRIVER ---
+
+// Work is cut into fixed-size chunks and chunk c always draws from RNG stream c
+// of the run seed. The chunks run on the shared work pool (pool.h), claimed through
+// one atomic counter, so the totals depend only on the seed, never on the thread
+// count or scheduling. Each participant keeps a private tally (a cache line apart
+// from its neighbours); partial tallies are merged after the join.
+const long long SIM_CHUNK = 1 << 16;
+
+// `batch(rng, count, stats)` processes `count` consecutive items of one chunk.
+template <class Stats, class Batch>
+Stats run_parallel_batches(long long total, long long chunk, int threads, std::uint64_t seed, Batch batch) {
+    struct alignas(64) Tally { Stats stats; };
+    std::vector<Tally> partial(static_cast<std::size_t>(std::max(threads, 1)));
+    long long chunks = (total + chunk - 1) / chunk;
+
+    auto run = [&](long long c, int slot) {
+        Rng rng(seed, static_cast<std::uint64_t>(c));
+        batch(rng, std::min(total - c * chunk, chunk), partial[static_cast<std::size_t>(slot)].stats);
+        record_commit();    // A chunk's games go out in one write (--record)
+    };
+    work_pool().parallel_chunks(chunks, threads, run);
+
+    Stats merged;
+    for (const Tally& t : partial) merged.merge(t.stats);
+    return merged;
+}
+
+// One `play(rng, stats)` call per game.
+template <class Stats, class Play>
+Stats run_parallel(long long games, int threads, std::uint64_t seed, Play play) {
+    return run_parallel_batches<Stats>(games, SIM_CHUNK, threads, seed, [&play](Rng& rng, long long count, Stats& stats) {
+        for (long long i = 0; i < count; i++) play(rng, stats);
+    });
+}
+
+inline int sim_thread_count(int requested) {
+    int threads = requested > 0 ? requested : static_cast<int>(std::thread::hardware_concurrency());
+    return threads > 0 ? threads : 1;
+}
+
+// Dice Monte Carlo: big chunks so the vector kernel amortizes its lane seeding.
+const long long DICE_MC_CHUNK = 1 << 22;
+
+inline DiceBatchStats run_dice_monte_carlo(long long rolls, int threads, std::uint64_t seed) {
+    return run_parallel_batches<DiceBatchStats>(rolls, DICE_MC_CHUNK, threads, seed, [](Rng& rng, long long count, DiceBatchStats& stats) {
+        dice_batch(rng, static_cast<std::uint64_t>(count), stats);
+    });
+}
+
+// RPS tournament: each chunk is one match, long enough for the models to settle.
+const long long RPS_MATCH_ROUNDS = 1000;
+
+inline RpsSimStats run_rps_pairing(long long rounds, int threads, std::uint64_t seed, RpsStrategy first, RpsStrategy second) {
+    return run_parallel_batches<RpsSimStats>(rounds, RPS_MATCH_ROUNDS, threads, seed, [=](Rng& rng, long long count, RpsSimStats& stats) {
+        sim_rps_match(rng, count, first, second, stats);
+    });
+}
+
+// Every word of the dictionary once. Workers take consecutive slices of the list, so
+// each word is played exactly once whatever the thread count; the solver draws no
+// randomness, so the totals are fixed by the dictionary alone.
+const long long HANGMAN_SIM_CHUNK = 256;
+
+inline HangmanSimStats run_hangman_sweep(int threads) {
+    const HangmanDictionary& dict = hangman_dictionary();
+    const HangmanSolverIndex& index = hangman_solver_index();
+    std::atomic<long long> nextWord{0};
+    long long words = static_cast<long long>(dict.size());
+    return run_parallel_batches<HangmanSimStats>(words, HANGMAN_SIM_CHUNK, threads, 0, [&](Rng&, long long count, HangmanSimStats& stats) {
+        thread_local HangmanSolver solver;
+        long long first = nextWord.fetch_add(count, std::memory_order_relaxed);
+        for (long long i = first; i < first + count; i++) {
+            const HangmanEntry& e = dict.entry(static_cast<std::size_t>(i));
+            sim_hangman_game(solver, index, dict.word(e), stats);
+        }
+    });
+}
+
+// --- REPORTING ---
+
+inline void sim_print_header(const char* title, long long games, int threads, double seconds) {
+    std::cout << "\n[SIM] " << title << "\n";
+    std::cout << "      games: " << games << "   threads: " << threads
+              << "   time: " << std::fixed << std::setprecision(3) << seconds << " s"
+              << "   games/sec: " << std::setprecision(0) << (seconds > 0 ? games / seconds : 0.0) << "\n";
+}
+
+inline void sim_print_share(const char* label, long long count, long long total) {
+    std::cout << "      " << std::left << std::setw(10) << label << std::right << std::setw(14) << count
+              << "  (" << std::fixed << std::setprecision(3) << (total ? 100.0 * count / total : 0.0) << "%)\n";
+}
+
+// 95% Wilson score interval for k successes out of n.
+inline void wilson_interval(double k, double n, double& lo, double& hi) {
+    const double z = 1.959963984540054;
+    if (n <= 0) { lo = hi = 0; return; }
+    double p = k / n, z2n = z * z / n;
+    double center = (p + z2n / 2) / (1 + z2n);
+    double half = z * std::sqrt(p * (1 - p) / n + z2n / (4 * n)) / (1 + z2n);
+    lo = center - half;
+    hi = center + half;
+}
+
+inline void sim_print_estimate(std::ostream& os, const char* label, std::uint64_t count, std::uint64_t total, double expected) {
+    double lo, hi;
+    wilson_interval(static_cast<double>(count), static_cast<double>(total), lo, hi);
+    os << "      " << std::left << std::setw(10) << label << std::right << std::setw(14) << count
+              << "  " << std::fixed << std::setprecision(4) << (total ? 100.0 * count / total : 0.0) << "%"
+              << "  CI95 [" << 100 * lo << ", " << 100 * hi << "]"
+              << "  exact " << 100 * expected << "%" << ((expected < lo || expected > hi) ? "  <-- outside CI" : "") << "\n";
+}
+
+// Doubles rate and sum distribution against the exact engine's two-d6 odds, plus a
+// chi-square goodness-of-fit over the 11 sums (10 degrees of freedom).
+inline void print_dice_report(std::ostream& os, const DiceBatchStats& s, int threads, double seconds) {
+    std::ios saved(nullptr);
+    saved.copyfmt(os);      // The UI shares this stream; leave its formatting as found
+    os << "\n[SIM] Dice Monte Carlo (two d6, " << dice_kernel_name() << " kernel)\n";
+    os << "      rolls: " << s.rolls << "   threads: " << threads
+              << "   time: " << std::fixed << std::setprecision(3) << seconds << " s"
+              << "   rolls/sec: " << std::setprecision(0) << (seconds > 0 ? s.rolls / seconds : 0.0) << "\n";
+    sim_print_estimate(os, "Doubles", s.doubles, s.rolls, dice_distribution(2, 6)->p_all_equal());
+
+    std::shared_ptr<const DiceDistribution> exact = dice_distribution(2, 6);
+    double chi2 = 0;
+    for (int sum = 2; sum <= 12; sum++) {
+        double expected = exact->p_sum(sum);
+        std::string label = "Sum " + std::to_string(sum);
+        sim_print_estimate(os, label.c_str(), s.sums[sum], s.rolls, expected);
+        double e = expected * s.rolls;
+        if (e > 0) chi2 += (s.sums[sum] - e) * (s.sums[sum] - e) / e;
+    }
+    os << "      chi-square (10 dof): " << std::setprecision(2) << chi2
+              << (chi2 > 23.21 ? "  FAIL (p < 0.01)" : "  ok (p >= 0.01 cutoff 23.21)") << "\n";
+    os.copyfmt(saved);
+}
+
+template <class Stats, class Play>
+Stats sim_timed(const SimConfig& config, int threads, double& seconds, Play play) {
+    auto start = std::chrono::steady_clock::now();
+    Stats stats = run_parallel<Stats>(config.games, threads, config.seed, play);
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+// Returns the process exit code.
+inline int run_simulation(const SimConfig& config) {
+    int threads = sim_thread_count(config.threads);
+    work_pool_threads() = threads;
+
+    bool all = (config.game == "all");
+    bool known = all || config.game == "ttt" || config.game == "rps" || config.game == "dice" || config.game == "secret" ||
+                 config.game == "hangman";
+    if (!known) {
+        std::cerr << "Unknown simulation '" << config.game << "' (expected ttt, rps, dice, secret, hangman or all).\n";
+        return 1;
+    }
+    if (config.games <= 0) {
+        std::cerr << "--games must be positive.\n";
+        return 1;
+    }
+
+    SimConfig run = config;
+    run.seed = rng_seed();
+    std::cout << "[SIM] seed: " << run.seed << "\n";
+
+    double seconds = 0;
+    if (all || config.game == "ttt") {
+        TttSimStats s = sim_timed<TttSimStats>(run, threads, seconds, sim_ttt_game);
+        sim_print_header("Tic-Tac-Toe (random X vs tablebase O)", s.games, threads, seconds);
+        sim_print_share("X wins", s.xWins, s.games);
+        sim_print_share("O wins", s.oWins, s.games);
+        sim_print_share("Draws", s.draws, s.games);
+        metric_count(COUNT_SIM_TTT, static_cast<std::uint64_t>(s.games));
+    }
+    if (all || config.game == "rps") {
+        // Round robin, --games rounds per pairing, each pairing on its own seed stream
+        RpsSimStats results[RPS_STRATEGIES][RPS_STRATEGIES];
+        long long rounds = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int a = 0; a < RPS_STRATEGIES; a++) {
+            for (int b = a + 1; b < RPS_STRATEGIES; b++) {
+                std::uint64_t state = run.seed ^ static_cast<std::uint64_t>(a * RPS_STRATEGIES + b);
+                results[a][b] = run_rps_pairing(run.games, threads, splitmix64(state), RpsStrategy(a), RpsStrategy(b));
+                rounds += results[a][b].rounds;
+            }
+        }
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        metric_count(COUNT_SIM_RPS, static_cast<std::uint64_t>(rounds));
+        sim_print_header("Rock, Paper, Scissors tournament (rounds, row player's side)", rounds, threads, seconds);
+        for (int a = 0; a < RPS_STRATEGIES; a++) {
+            for (int b = a + 1; b < RPS_STRATEGIES; b++) {
+                const RpsSimStats& s = results[a][b];
+                double n = s.rounds ? double(s.rounds) : 1.0;
+                std::cout << "      " << std::left << std::setw(10) << rps_strategy_name(a) << "vs " << std::setw(10) << rps_strategy_name(b)
+                          << std::right << std::setprecision(1)
+                          << " win " << std::setw(5) << 100 * s.wins / n << "%"
+                          << "  loss " << std::setw(5) << 100 * s.losses / n << "%"
+                          << "  tie " << std::setw(5) << 100 * s.ties / n << "%\n";
+            }
+        }
+    }
+    if (all || config.game == "dice") {
+        auto start = std::chrono::steady_clock::now();
+        DiceBatchStats s = run_dice_monte_carlo(run.games, threads, run.seed);
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        print_dice_report(std::cout, s, threads, seconds);
+        metric_count(COUNT_SIM_DICE, static_cast<std::uint64_t>(s.rolls));
+    }
+    if (all || config.game == "secret") {
+        SecretSimStats s = sim_timed<SecretSimStats>(run, threads, seconds, sim_secret_round);
+        sim_print_header("Secret Number (bisection over 1-100)", s.rounds, threads, seconds);
+        metric_count(COUNT_SIM_SECRET, static_cast<std::uint64_t>(s.rounds));
+        std::cout << "      avg attempts: " << std::setprecision(3) << (s.rounds ? double(s.attempts) / s.rounds : 0.0) << "\n";
+        for (int a = 1; a < 8; a++) {
+            std::string label = std::to_string(a) + " tries";
+            sim_print_share(label.c_str(), s.histogram[a], s.rounds);
+        }
+        const std::uint64_t FULL = ~std::uint64_t(0);
+        const SecretScenario scenarios[] = {
+            { "Secret Number (bisection over 0-2^64)", 0, FULL, 0.0, -1, { SECRET_BISECT, 0, 0 } },
+            { "Secret Number (10% noisy answers, vote by 3, 0-2^32)", 0, 0xFFFFFFFFu, 0.10, -1, { SECRET_VOTE, 3, 0 } },
+            { "Secret Number (10% noisy answers, vote by 3, 0-2^64)", 0, FULL, 0.10, -1, { SECRET_VOTE, 3, 0 } },
+            { "Secret Number (up to 3 lies, liar-safe, 0-2^64)", 0, FULL, 0.25, 3, { SECRET_LIAR_SAFE, 0, 3 } },
+        };
+        for (const SecretScenario& scenario : scenarios) {
+            SecretSimStats t = sim_timed<SecretSimStats>(run, threads, seconds, [&scenario](Rng& rng, SecretSimStats& stats) {
+                sim_secret_scenario_round(rng, scenario, stats);
+            });
+            sim_print_header(scenario.title, t.rounds, threads, seconds);
+            metric_count(COUNT_SIM_SECRET, static_cast<std::uint64_t>(t.rounds));
+            double n = t.rounds ? double(t.rounds) : 1.0;
+            std::cout << "      avg attempts: " << std::setprecision(2) << t.attempts / n
+                      << "   avg restarts: " << std::setprecision(3) << t.restarts / n << "\n";
+            sim_print_share("Unsolved", t.failed, t.rounds);
+        }
+    }
+    if (all || config.game == "hangman") {
+        auto start = std::chrono::steady_clock::now();
+        hangman_solver_index();     // Built once up front; not part of the games/sec figure
+        auto ready = std::chrono::steady_clock::now();
+        HangmanSimStats s = run_hangman_sweep(threads);
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - ready).count();
+        sim_print_header(hangman_use_avx2() ? "Hangman solver, whole dictionary (AVX2 filter)" : "Hangman solver, whole dictionary (scalar filter)",
+                         s.games, threads, seconds);
+        metric_count(COUNT_SIM_HANGMAN, static_cast<std::uint64_t>(s.games));
+        std::cout << "      index build: " << std::setprecision(3) << std::chrono::duration<double>(ready - start).count() << " s"
+                  << "   avg guesses: " << (s.games ? double(s.guesses) / s.games : 0.0)
+                  << "   avg misses: " << (s.games ? double(s.misses) / s.games : 0.0) << "\n";
+        sim_print_share("Solved", s.solved, s.games);
+        for (int m = 0; m < 27; m++) {
+            if (s.histogram[m] == 0) continue;
+            std::string label = std::to_string(m) + " misses";
+            sim_print_share(label.c_str(), s.histogram[m], s.games);
+        }
+    }
+
+    PoolStats pool = work_pool().stats();
+    std::cout << "[SIM] pool: " << pool.workers << " workers, " << pool.executed << " jobs, " << pool.steals << " steals\n";
+    if (record_log().is_open()) {
+        std::cout << "[SIM] records: " << record_log().records_written() << " written"
+                  << (record_log().ok() ? "" : " (write errors; the log is incomplete)") << "\n";
+    }
+    return 0;
+}
+
+#endif
@@ -0,0 +1,132 @@
+/**
+ * ======================================================================================
+ * TASKS
+ * The C++20 coroutine type the UI is written in. A game loop reads top to bottom as
+ * before, but every prompt and pause is a `co_await`: on the console the awaited
+ * input is simply read on the spot, while a network session suspends there and the
+ * server loop resumes it when the player's key (or a timer) arrives. That lets one
+ * thread keep thousands of games in progress without a stack per game.
+ * ======================================================================================
+ */
+
+#ifndef GAMEHUB_TASK_H
+#define GAMEHUB_TASK_H
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+#include "arena.h"
+
+// Lazy: a task starts when first awaited (or start()ed). Awaiting runs it right away,
+// like a call; if it finishes without suspending (always, on the console) the awaiter
+// simply carries on, so a long session nests no deeper than its call chain. A task
+// that did suspend is resumed later by the server loop and, when it finishes, jumps
+// back into whoever awaited it. Exceptions travel to the awaiter either way.
+template <class T = void>
+class Task;
+
+struct TaskPromiseBase {
+    std::coroutine_handle<> continuation = std::noop_coroutine();
+    std::exception_ptr error;
+    bool awaitedInline = false;     // The awaiter is still inside await_suspend, waiting
+
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        template <class Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> self) noexcept {
+            TaskPromiseBase& p = self.promise();
+            return p.awaitedInline ? std::noop_coroutine() : p.continuation;
+        }
+        void await_resume() const noexcept {}
+    };
+
+    // Frames come from the running session's arena (arena.h)
+    static void* operator new(std::size_t bytes) { return frame_allocate(bytes); }
+    static void operator delete(void* frame, std::size_t bytes) { frame_free(frame, bytes); }
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() { error = std::current_exception(); }
+};
+
+template <class T>
+struct TaskPromise : TaskPromiseBase {
+    T value{};
+    Task<T> get_return_object();
+    void return_value(T v) { value = std::move(v); }
+    T result() {
+        if (error) std::rethrow_exception(error);
+        return std::move(value);
+    }
+};
+
+template <>
+struct TaskPromise<void> : TaskPromiseBase {
+    Task<void> get_return_object();
+    void return_void() const noexcept {}
+    void result() {
+        if (error) std::rethrow_exception(error);
+    }
+};
+
+template <class T>
+class [[nodiscard]] Task {
+public:
+    using promise_type = TaskPromise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Task() = default;
+    explicit Task(Handle h) : handle(h) {}
+    Task(Task&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle) handle.destroy();
+            handle = std::exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() { if (handle) handle.destroy(); }
+
+    // Awaiting runs the task; its result (or exception) comes back from co_await.
+    // Returns false (keep going) when it already finished.
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> awaiting) {
+        promise_type& p = handle.promise();
+        p.continuation = awaiting;
+        p.awaitedInline = true;
+        handle.resume();
+        p.awaitedInline = false;
+        return !handle.done();
+    }
+    T await_resume() { return handle.promise().result(); }
+
+    // Top-level use: start it, check on it, collect it.
+    void start() { handle.resume(); }
+    bool done() const { return !handle || handle.done(); }
+    T result() { return handle.promise().result(); }
+
+private:
+    Handle handle = nullptr;
+};
+
+template <class T>
+Task<T> TaskPromise<T>::get_return_object() {
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() {
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+// Runs a task whose awaits all complete on the spot (the console) to the end, and
+// returns its result, rethrowing whatever it threw.
+template <class T>
+T run_blocking(Task<T> task) {
+    task.start();
+    return task.result();
+}
+
+#endif
@@ -0,0 +1,553 @@
+/**
+ * ======================================================================================
+ * TERMINAL LAYER
+ * Clears and positions the cursor in-process with ANSI/VT escape sequences instead
+ * of spawning `clear`/`cls` through system(). On Windows the console is switched
+ * into VT mode once at startup; consoles too old for VT fall back to the console
+ * API, which is still in-process.
+ *
+ * All screen output is composed into one reusable FrameBuffer (colors included, as
+ * inline SGR sequences) and leaves the process in a single write when the frame is
+ * presented - right before the program waits for input or pauses. On an
+ * interactive terminal only the cells that changed since the previous frame are
+ * sent, using cursor-addressed updates.
+ * ======================================================================================
+ */
+
+#ifndef GAMEHUB_TERM_H
+#define GAMEHUB_TERM_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "metrics.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX   // Keep std::min/std::max usable in the engine headers
+#endif
+#include <windows.h>
+#else
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+#ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
+#define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
+#endif
+#endif
+
+// --- ESCAPE SEQUENCES ---
+const char* const ANSI_HOME = "\x1b[H";
+const char* const ANSI_CLEAR_SCREEN = "\x1b[2J";
+const char* const ANSI_CLEAR_SCROLLBACK = "\x1b[3J";
+
+// 1-based row/column, as the VT protocol counts them.
+inline void ansi_cursor_to(std::ostream& out, int row, int col) {
+    out << "\x1b[" << row << ';' << col << 'H';
+}
+
+#ifdef _WIN32
+// Looked up once; the standard handles don't change under a running program.
+inline HANDLE console_output() {
+    static const HANDLE handle = GetStdHandle(STD_OUTPUT_HANDLE);
+    return handle;
+}
+#endif
+
+// True once the output understands VT sequences (always the case off Windows).
+inline bool& terminal_vt_enabled() {
+    static bool enabled = true;
+    return enabled;
+}
+
+inline void terminal_init() {
+#ifdef _WIN32
+    HANDLE out = console_output();
+    DWORD mode = 0;
+    terminal_vt_enabled() = out != INVALID_HANDLE_VALUE && GetConsoleMode(out, &mode) &&
+                            SetConsoleMode(out, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+#endif
+}
+
+// Colors unless the NO_COLOR convention asks for none.
+inline bool terminal_color_enabled() {
+    static const bool enabled = std::getenv("NO_COLOR") == nullptr;
+    return enabled;
+}
+
+// Console attribute (Windows color code: 1 blue, 2 green, 4 red, 8 bright) as the
+// equivalent SGR sequence; 7 is the default grey and maps to a plain reset.
+inline void ansi_color(std::string& out, int color) {
+    if (color == 7) { out += "\x1b[0m"; return; }
+    int ansi = (color & 8 ? 90 : 30) + (color & 4 ? 1 : 0) + (color & 2 ? 2 : 0) + (color & 1 ? 4 : 0);
+    out += "\x1b[";
+    out += static_cast<char>('0' + ansi / 10);
+    out += static_cast<char>('0' + ansi % 10);
+    out += 'm';
+}
+
+// --- FRAME BUFFER ---
+
+// A streambuf that appends into one string. The string keeps its capacity between
+// frames, so steady-state frames never allocate. Flushes (std::endl, std::flush) are
+// deliberately no-ops: only Terminal::present() sends anything.
+//
+// It also holds the pen. set_pen() only notes the color; the escape goes in right
+// before the next character, and only if the color in effect differs. A color set
+// twice with nothing drawn in between, or set to what it already is, costs nothing.
+class FrameBuffer : public std::streambuf {
+public:
+    explicit FrameBuffer(std::size_t reserve = 16 * 1024) { data.reserve(reserve); }
+
+    std::string& str() { return data; }
+    void clear() { data.clear(); }
+
+    void set_pen(int color) { wanted = color; }
+
+    // The output is drawing in `color` here (-1: unknown, so the next color is written
+    // whatever it is), and that is what the text after it wants too.
+    void reset_pen(int color) { pen = color; wanted = 7; }
+
+    // Writes a pending color change now; text typed at the prompt is echoed in it.
+    void flush_pen() {
+        if (wanted == pen) return;
+        ansi_color(data, wanted);
+        pen = wanted;
+    }
+
+protected:
+    int_type overflow(int_type ch) override {
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            flush_pen();
+            data.push_back(traits_type::to_char_type(ch));
+        }
+        return traits_type::not_eof(ch);
+    }
+    std::streamsize xsputn(const char* s, std::streamsize n) override {
+        flush_pen();
+        data.append(s, static_cast<std::size_t>(n));
+        return n;
+    }
+    int sync() override { return 0; }
+
+private:
+    std::string data;
+    int pen = 7;        // Color of the last character written
+    int wanted = 7;     // Color the next character is drawn in
+};
+
+// --- SCREEN MODEL ---
+
+// One character cell: glyph plus the console color it was drawn in.
+struct Cell {
+    char ch = ' ';
+    unsigned char color = 7;
+    bool operator==(const Cell& o) const { return ch == o.ch && color == o.color; }
+    bool operator!=(const Cell& o) const { return !(*this == o); }
+};
+
+// Keeps what is on the terminal (front) and what the current frame wants (back),
+// and turns the difference into cursor-addressed updates. Frames are composed as
+// plain text exactly as before; apply() interprets that text (tabs, \r, \b, \n and our
+// SGR color codes) into the back grid. Anything the model cannot represent - a line
+// wider than the terminal or a frame taller than it - makes apply() fail, and the
+// caller falls back to a full redraw.
+class ScreenModel {
+public:
+    int rows() const { return height; }
+    int cols() const { return width; }
+
+    void resize(int newRows, int newCols) {
+        height = newRows;
+        width = newCols;
+        front.assign(static_cast<std::size_t>(height) * width, Cell());
+        back.assign(front.size(), Cell());
+        frontValid = false;
+    }
+
+    void invalidate() { frontValid = false; }
+
+    void reset_back() {
+        std::fill(back.begin(), back.end(), Cell());
+        row = col = 0;
+        color = 7;
+    }
+
+    bool apply(const char* text, std::size_t n) { return paint(back, text, n); }
+
+    // Text the terminal printed on its own (line-mode input echo). It is already on
+    // screen, so it lands in both grids.
+    bool echo(const char* text, std::size_t n) {
+        int r = row, c = col;
+        unsigned char k = color;
+        if (!paint(back, text, n)) return false;
+        std::swap(r, row); std::swap(c, col); std::swap(k, color);
+        bool ok = paint(front, text, n);
+        std::swap(r, row); std::swap(c, col); std::swap(k, color);
+        return ok;
+    }
+
+    // Appends the escape sequences that turn front into back, then adopts back.
+    void diff(std::string& outBuf) {
+        if (!frontValid) {
+            outBuf.append("\x1b[0m").append(ANSI_HOME).append(ANSI_CLEAR_SCREEN).append(ANSI_CLEAR_SCROLLBACK);
+            std::fill(front.begin(), front.end(), Cell());
+            curRow = curCol = 0;
+            curColor = 7;
+            frontValid = true;
+        }
+
+        for (int r = 0; r < height; r++) {
+            Cell* f = &front[static_cast<std::size_t>(r) * width];
+            const Cell* b = &back[static_cast<std::size_t>(r) * width];
+            int blankFrom = width;
+            while (blankFrom > 0 && b[blankFrom - 1] == Cell()) blankFrom--;
+
+            for (int c = 0; c < width; ) {
+                if (f[c] == b[c]) { c++; continue; }
+
+                // The rest of the wanted row is empty: one erase-to-end-of-line.
+                if (c >= blankFrom) {
+                    move_to(outBuf, r, c);
+                    set_emitted_color(outBuf, 7);
+                    outBuf.append("\x1b[K");
+                    std::fill(f + c, f + width, Cell());
+                    break;
+                }
+
+                // Extend the run across short unchanged gaps; rewriting a few equal
+                // cells is cheaper than another cursor jump.
+                int last = c;
+                for (int j = c + 1; j < blankFrom && j - last <= 4; j++) if (f[j] != b[j]) last = j;
+
+                move_to(outBuf, r, c);
+                for (int j = c; j <= last; j++) {
+                    set_emitted_color(outBuf, b[j].color);
+                    outBuf.push_back(b[j].ch);
+                    f[j] = b[j];
+                }
+                curCol = last + 1;
+                c = last + 1;
+            }
+        }
+
+        move_to(outBuf, row, col);
+        set_emitted_color(outBuf, color);
+    }
+
+private:
+    bool paint(std::vector<Cell>& grid, const char* text, std::size_t n) {
+        for (std::size_t i = 0; i < n; i++) {
+            char ch = text[i];
+            if (ch == '\n') { row++; col = 0; }
+            else if (ch == '\r') col = 0;
+            else if (ch == '\b') { if (col > 0) col--; }
+            else if (ch == '\t') col = (col / 8 + 1) * 8;
+            else if (ch == '\x1b') {
+                // Only the SGR color codes our own set_color() writes appear here.
+                std::size_t end = i + 1;
+                while (end < n && text[end] != 'm') end++;
+                int code = 0;
+                for (std::size_t j = i + 2; j < end; j++) code = code * 10 + (text[j] - '0');
+                color = static_cast<unsigned char>(sgr_to_color(code));
+                i = end;
+                continue;
+            } else {
+                if (row >= height || col >= width) return false;
+                grid[static_cast<std::size_t>(row) * width + col] = { ch, color };
+                col++;
+                continue;
+            }
+            if (row >= height || col > width) return false;
+        }
+        return true;
+    }
+
+    static int sgr_to_color(int code) {
+        if (code < 30) return 7;
+        int c = code % 10;
+        return (code >= 90 ? 8 : 0) | (c & 1 ? 4 : 0) | (c & 2 ? 2 : 0) | (c & 4 ? 1 : 0);
+    }
+
+    void move_to(std::string& outBuf, int r, int c) {
+        if (r == curRow && c == curCol) return;
+        outBuf.append("\x1b[");
+        append_int(outBuf, r + 1);
+        outBuf.push_back(';');
+        append_int(outBuf, c + 1);
+        outBuf.push_back('H');
+        curRow = r;
+        curCol = c;
+    }
+
+    void set_emitted_color(std::string& outBuf, int k) {
+        if (k == curColor) return;
+        ansi_color(outBuf, k);
+        curColor = k;
+    }
+
+    static void append_int(std::string& outBuf, int v) {
+        char digits[12];
+        int n = 0;
+        do { digits[n++] = static_cast<char>('0' + v % 10); v /= 10; } while (v > 0);
+        while (n > 0) outBuf.push_back(digits[--n]);
+    }
+
+    int height = 0, width = 0;
+    std::vector<Cell> front, back;
+    bool frontValid = false;
+    int row = 0, col = 0;                       // Back-grid cursor
+    unsigned char color = 7;                    // Back-grid pen
+    int curRow = 0, curCol = 0, curColor = 7;   // What the real terminal is at
+};
+
+// Size of the visible window, or false when stdout is not an interactive terminal.
+inline bool terminal_size(int& rows, int& cols) {
+#ifdef _WIN32
+    CONSOLE_SCREEN_BUFFER_INFO info;
+    if (!GetConsoleScreenBufferInfo(console_output(), &info)) return false;
+    rows = info.srWindow.Bottom - info.srWindow.Top + 1;
+    cols = info.srWindow.Right - info.srWindow.Left + 1;
+#else
+    struct winsize ws;
+    if (!isatty(STDOUT_FILENO) || ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) != 0) return false;
+    rows = ws.ws_row;
+    cols = ws.ws_col;
+#endif
+    return rows > 0 && cols > 0;
+}
+
+// Incremental redraw switch; --full-redraw turns it off.
+inline bool& terminal_diff_enabled() {
+    static bool enabled = true;
+    return enabled;
+}
+
+// --- OUTPUT DIGEST ---
+
+// FNV-1a over everything a session showed, so replayed runs can be compared between
+// builds by checksum alone.
+struct OutputDigest {
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    std::uint64_t bytes = 0;
+
+    void add(const char* p, std::size_t n) {
+        std::uint64_t h = hash;
+        for (std::size_t i = 0; i < n; i++) {
+            h ^= static_cast<unsigned char>(p[i]);
+            h *= 0x100000001b3ULL;
+        }
+        hash = h;
+        bytes += n;
+    }
+};
+
+// --- TERMINAL ---
+
+class Terminal {
+    FrameBuffer frame;              // Declared first: `out` is bound to it on construction
+    std::size_t sent = 0;           // Bytes of the current frame already handled
+    bool clearPending = false;      // Legacy-console clear deferred to present()
+    bool diffing = false;           // This frame is drawn through the screen model
+    bool frameShown = false;        // Part of this frame is already on screen
+    ScreenModel screen;
+    std::string update;             // Reused diff output
+    OutputDigest* sink = nullptr;   // Replay capture: hash the text instead of writing it
+    std::string* remote = nullptr;  // Network session: queue the text for its socket
+
+public:
+    Terminal() : out(&frame) { update.reserve(4096); }
+
+    // A network player's screen: presented text is appended to `outbox` with telnet
+    // line endings, every frame is a full repaint, and nothing is reserved up front
+    // (idle sessions are meant to be small).
+    explicit Terminal(std::string* outbox) : frame(0), remote(outbox), out(&frame) {}
+    Terminal(const Terminal&) = delete;
+    Terminal& operator=(const Terminal&) = delete;
+
+    // Starts a fresh screen. Anything composed but not yet presented would be wiped
+    // before it could be seen, so it is simply dropped. On an interactive VT terminal
+    // the new frame is diffed against what is on screen; otherwise it is preceded by a
+    // full clear. Every frame starts in the default color.
+    void begin_frame() {
+        frame.clear();
+        sent = 0;
+        frameShown = false;
+        if (sink) { diffing = false; return; }
+
+        int rows = 0, cols = 0;
+        diffing = !remote && terminal_diff_enabled() && terminal_vt_enabled() && terminal_size(rows, cols);
+        if (diffing) {
+            if (rows != screen.rows() || cols != screen.cols()) screen.resize(rows, cols);
+            screen.reset_back();
+            frame.reset_pen(7);     // The screen model starts every frame at 7 too
+            return;
+        }
+        screen.invalidate();
+        frame.reset_pen(-1);        // Whatever the last frame (or diff) left the terminal in
+        if (terminal_vt_enabled() || remote) frame.str().append(ANSI_HOME).append(ANSI_CLEAR_SCREEN).append(ANSI_CLEAR_SCROLLBACK);
+        else clearPending = true;
+    }
+
+    // Inline SGR codes on every platform; the legacy Windows console turns them back
+    // into attribute changes as it writes (write_out).
+    void set_color(int color) {
+        if (sink || !terminal_color_enabled()) return;  // Capture checksums stay the same everywhere
+        frame.set_pen(color);
+    }
+
+    // Sends everything composed since the last present in one write: only the changed
+    // cells when diffing, the raw text otherwise.
+    void present() {
+        frame.flush_pen();
+        std::string& data = frame.str();
+        if (sent == data.size() && !clearPending) return;
+        MetricTimer timer(METRIC_RENDER_PRESENT);
+
+        if (sink) {
+            sink->add(data.data() + sent, data.size() - sent);
+            sent = data.size();
+            return;
+        }
+
+        if (diffing) {
+            if (screen.apply(data.data() + sent, data.size() - sent)) {
+                update.clear();
+                screen.diff(update);
+                emit(update.data(), update.size());
+                sent = data.size();
+                frameShown = true;
+                return;
+            }
+            // Too big for the model: stream the rest as-is and redraw fully next frame.
+            diffing = false;
+            screen.invalidate();
+            if (!frameShown) {
+                update.assign("\x1b[0m").append(ANSI_HOME).append(ANSI_CLEAR_SCREEN).append(ANSI_CLEAR_SCROLLBACK);
+                emit(update.data(), update.size());
+                sent = 0;
+            }
+        }
+        emit(data.data() + sent, data.size() - sent);
+        sent = data.size();
+    }
+
+    // Sends presented text (no clears, no colors) to `digest` instead of the console;
+    // nullptr goes back to normal output. The current frame is dropped.
+    void capture(OutputDigest* digest) {
+        sink = digest;
+        frame.clear();
+        sent = 0;
+        clearPending = false;
+        screen.invalidate();
+    }
+
+    // The next present repaints everything from a cleared screen.
+    void resync() {
+        screen.invalidate();
+    }
+
+    // The terminal echoed a line the player typed; keep the model in step with it.
+    void echoed(const std::string& line) {
+        if (!diffing) return;
+        if (!screen.echo(line.data(), line.size()) || !screen.echo("\n", 1)) {
+            diffing = false;
+            screen.invalidate();
+        }
+    }
+
+    std::ostream out;
+
+private:
+    void emit(const char* data, std::size_t size) {
+        if (!remote) { write_out(data, size); return; }
+        for (std::size_t i = 0; i < size; i++) {
+            if (data[i] == '\n') remote->push_back('\r');
+            remote->push_back(data[i]);
+        }
+    }
+
+#ifdef _WIN32
+    void write_out(const char* data, std::size_t size) {
+        HANDLE handle = console_output();
+        DWORD written = 0;
+        if (terminal_vt_enabled()) {
+            WriteFile(handle, data, static_cast<DWORD>(size), &written, nullptr);
+            return;
+        }
+
+        // Legacy console: clear through the API and replay our own SGR codes as
+        // attribute changes between plain-text runs.
+        if (clearPending) {
+            CONSOLE_SCREEN_BUFFER_INFO info;
+            if (GetConsoleScreenBufferInfo(handle, &info)) {
+                DWORD cells = info.dwSize.X * info.dwSize.Y;
+                COORD origin = { 0, 0 };
+                FillConsoleOutputCharacterA(handle, ' ', cells, origin, &written);
+                FillConsoleOutputAttribute(handle, info.wAttributes, cells, origin, &written);
+                SetConsoleCursorPosition(handle, origin);
+            }
+            clearPending = false;
+        }
+        std::size_t start = 0;
+        for (std::size_t i = 0; i < size; i++) {
+            if (data[i] != '\x1b') continue;
+            std::size_t end = i;
+            while (end < size && data[end] != 'm') end++;
+            if (end == size) break;
+            WriteFile(handle, data + start, static_cast<DWORD>(i - start), &written, nullptr);
+            int code = std::atoi(data + i + 2);
+            WORD attr = 7;
+            if (code >= 30) {
+                int c = code % 10;
+                attr = static_cast<WORD>((code >= 90 ? 8 : 0) | (c & 1 ? 4 : 0) | (c & 2 ? 2 : 0) | (c & 4 ? 1 : 0));
+            }
+            SetConsoleTextAttribute(handle, attr);
+            start = i = end;
+            start++;
+        }
+        WriteFile(handle, data + start, static_cast<DWORD>(size - start), &written, nullptr);
+    }
+#else
+    void write_out(const char* p, std::size_t left) {
+        while (left > 0) {
+            ssize_t n = ::write(STDOUT_FILENO, p, left);
+            if (n <= 0) break;
+            p += n;
+            left -= static_cast<std::size_t>(n);
+        }
+    }
+#endif
+};
+
+// The process console.
+inline Terminal& console_terminal() {
+    static Terminal console;
+    return console;
+}
+
+// The terminal bound to this thread while it runs a network session (null = console).
+inline Terminal*& terminal_binding() {
+    thread_local Terminal* bound = nullptr;
+    return bound;
+}
+
+inline Terminal& terminal() {
+    Terminal* bound = terminal_binding();
+    return bound ? *bound : console_terminal();
+}
+
+// Stream the UI composes screens into.
+inline std::ostream& out() {
+    return terminal().out;
+}
+
+#endif
@@ -0,0 +1,167 @@
+/**
+ * ======================================================================================
+ * TIC-TAC-TOE ENGINE
+ * Bitboard representation, compile-time tablebase and the move/win kernels.
+ * Everything here works on an explicit TttBoard, so it is safe to run one game per
+ * thread without any shared state.
+ * ======================================================================================
+ */
+
+#ifndef GAMEHUB_TTT_H
+#define GAMEHUB_TTT_H
+
+#include "rng.h"
+
+// --- TIC-TAC-TOE BITBOARD ---
+// Each side owns a 9-bit occupancy mask; bit i is sector i+1 (row-major).
+struct TttBoard {
+    unsigned short x = 0;
+    unsigned short o = 0;
+};
+
+constexpr unsigned short TTT_FULL = 0x1FF;
+
+// The 8 winning lines: 3 rows, 3 columns, 2 diagonals.
+constexpr unsigned short TTT_LINES[8] = {
+    0x007, 0x038, 0x1C0,    // Rows
+    0x049, 0x092, 0x124,    // Columns
+    0x111, 0x054            // Diagonals
+};
+
+// --- TIC-TAC-TOE TABLEBASE ---
+// Perfect-play table for all 3^9 cell assignments, generated at compile time.
+// A position is indexed in base 3 (digit i: 0 empty, 1 X, 2 O). The score is from
+// the side to move's view: 0 draw, +n win, -n loss, with larger |n| for quicker
+// results so the CPU wins fast and loses slow.
+constexpr int TTT_POSITIONS = 19683;
+constexpr unsigned char TTT_NO_MOVE = 0xFF;
+
+struct TttEntry {
+    signed char score;
+    unsigned char move;     // Best cell (0-8), or TTT_NO_MOVE for finished/illegal positions
+};
+
+struct TttTablebase {
+    unsigned short pow3[512];   // Base-3 index contribution of a 9-bit mask
+    TttEntry entry[TTT_POSITIONS];
+};
+
+inline constexpr TttTablebase build_tablebase() {
+    TttTablebase t{};
+    for (int mask = 0; mask < 512; mask++) {
+        int value = 0, p = 1;
+        for (int i = 0; i < 9; i++, p *= 3) if (mask & (1 << i)) value += p;
+        t.pow3[mask] = static_cast<unsigned short>(value);
+    }
+
+    // Center first, then corners, then edges: ties resolve the way a human expects.
+    const int order[9] = { 4, 0, 2, 6, 8, 1, 3, 5, 7 };
+
+    // A child always has a larger index than its parent (one more non-zero digit),
+    // so walking downwards resolves every child before it is needed.
+    for (int idx = TTT_POSITIONS - 1; idx >= 0; idx--) {
+        int x = 0, o = 0, rest = idx;
+        for (int i = 0; i < 9; i++, rest /= 3) {
+            if (rest % 3 == 1) x |= 1 << i;
+            else if (rest % 3 == 2) o |= 1 << i;
+        }
+
+        int nx = 0, no = 0;
+        for (int i = 0; i < 9; i++) { nx += (x >> i) & 1; no += (o >> i) & 1; }
+
+        TttEntry& e = t.entry[idx];
+        e.score = 0;
+        e.move = TTT_NO_MOVE;
+        if (nx != no && nx != no + 1) continue;
+
+        bool xWon = false, oWon = false;
+        for (unsigned short line : TTT_LINES) {
+            if ((x & line) == line) xWon = true;
+            if ((o & line) == line) oWon = true;
+        }
+        int empties = 9 - nx - no;
+        if (xWon || oWon) { e.score = static_cast<signed char>(-(1 + empties)); continue; }
+        if (empties == 0) continue;
+
+        bool xToMove = (nx == no);
+        int best = -100;
+        for (int cell : order) {
+            if ((x | o) & (1 << cell)) continue;
+            int child = idx + (xToMove ? 1 : 2) * t.pow3[1 << cell];
+            int score = -t.entry[child].score;
+            if (score > best) { best = score; e.move = static_cast<unsigned char>(cell); }
+        }
+        e.score = static_cast<signed char>(best);
+    }
+    return t;
+}
+
+constexpr TttTablebase TTT_TABLEBASE = build_tablebase();
+static_assert(TTT_TABLEBASE.entry[0].score == 0, "Perfect play from the empty board must draw");
+
+// --- BOARD KERNELS ---
+
+// Portable SWAR popcount; a 9-bit mask never needs more than the low 16 bits.
+inline int popcount9(unsigned int mask) {
+    mask = mask - ((mask >> 1) & 0x5555);
+    mask = (mask & 0x3333) + ((mask >> 2) & 0x3333);
+    mask = (mask + (mask >> 4)) & 0x0F0F;
+    return (mask + (mask >> 8)) & 0x1F;
+}
+
+inline void clearboard(TttBoard& board) {
+    board = TttBoard();
+}
+
+inline char cell_char(const TttBoard& board, int index) {
+    unsigned short bit = 1 << index;
+    if (board.x & bit) return 'X';
+    if (board.o & bit) return 'O';
+    return ' ';
+}
+
+// Slot is 1-based, matching the on-screen sector numbers.
+inline bool place_marker(TttBoard& board, int slot, char marker) {
+    unsigned short bit = 1 << (slot - 1);
+    if ((board.x | board.o) & bit) return false;
+
+    if (marker == 'X') board.x |= bit;
+    else board.o |= bit;
+    return true;
+}
+
+// Win test is AND-then-compare against each line mask; the draw test is a popcount.
+// Returns 'X' or 'O' for a win, 'D' for a draw and 'C' to continue.
+inline char check_winner(const TttBoard& board) {
+    for (unsigned short line : TTT_LINES) {
+        if ((board.x & line) == line) return 'X';
+        if ((board.o & line) == line) return 'O';
+    }
+
+    if (popcount9(board.x | board.o) == 9) return 'D'; // Draw
+    return 'C'; // Continue
+}
+
+// Perfect move for the side to move (0-8), or TTT_NO_MOVE once the game is over.
+inline int best_move(const TttBoard& board) {
+    int index = TTT_TABLEBASE.pow3[board.x] + 2 * TTT_TABLEBASE.pow3[board.o];
+    return TTT_TABLEBASE.entry[index].move;
+}
+
+// Perfect AI for 'O': a single tablebase lookup, no search at runtime
+inline void computer_turn(TttBoard& board) {
+    int move = best_move(board);
+    if (move != TTT_NO_MOVE) board.o |= 1 << move;
+}
+
+// Uniformly random empty cell (0-8); picks the k-th free bit instead of retrying.
+inline int random_move(const TttBoard& board, Rng& rng) {
+    unsigned int free = TTT_FULL & ~(board.x | board.o);
+    int k = static_cast<int>(rng.below(popcount9(free)));
+    while (k-- > 0) free &= free - 1;
+    int cell = 0;
+    while (!(free & (1u << cell))) cell++;
+    return cell;
+}
+
+#endif